@@ -0,0 +1,289 @@
+/*
+ * ai.c
+ *
+ * Computer opponent for Teeko: a negamax alpha-beta search with iterative
+ * deepening. Each iteration searches one ply deeper than the last, starting
+ * with the best move from the previous iteration. The search checks the
+ * timer0 clock as it goes and unwinds as soon as its deadline has passed.
+ * Results are cached in the transposition table (see ttable.h), which is
+ * kept between moves and emptied by ai_new_game(). Early in the drop phase
+ * the opening book (see book.h) is used instead, and no search is done.
+ */
+
+#include "ai.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "book.h"
+#include "game.h"
+#include "timer0.h"
+#include "ttable.h"
+
+// Scores are from the point of view of the player to move. A win is scored
+// as WIN_SCORE less the number of plies needed to reach it, so that quicker
+// wins (and slower losses) are preferred.
+#define WIN_SCORE		10000
+#define INFINITE_SCORE	32000
+
+// The clock is only read every this many nodes, since reading it briefly
+// disables interrupts
+#define NODES_PER_TIME_CHECK 16
+
+// the number of pieces after which every drop could complete a pattern
+#define LAST_DROPS_START (2 * PIECES_PER_PLAYER - 1)
+
+static uint16_t time_budget = AI_DEFAULT_TIME_BUDGET;
+static uint32_t search_deadline;
+static uint8_t search_aborted;
+static uint8_t nodes_until_time_check;
+
+// evaluation score for a winning pattern which holds this many of one
+// player's pieces and none of the other player's
+static const uint8_t pattern_scores[PIECES_PER_PLAYER + 1] PROGMEM =
+		{0, 1, 4, 16, 0};
+
+void ai_set_time_budget(uint16_t milliseconds) {
+	time_budget = milliseconds;
+}
+
+uint16_t ai_get_time_budget(void) {
+	return time_budget;
+}
+
+void ai_new_game(void) {
+	tt_clear();
+}
+
+// returns the bitboard 'own' after the move has been made
+static Bitboard apply_move(Bitboard own, MoveCode move) {
+	own |= (Bitboard)1 << move_to(move);
+	if (move < MOVE_DROP_BASE) {
+		own &= ~((Bitboard)1 << move_from(move));
+	}
+	return own;
+}
+
+// static evaluation of a position for the player who owns 'own'. Each
+// winning pattern still open to only one player counts for that player,
+// more so the more of their pieces it already holds.
+static int16_t evaluate(Bitboard own, Bitboard opponent) {
+	int16_t score = 0;
+	for (uint8_t i = 0; i < NUM_WIN_MASKS; i++) {
+		Bitboard mask = get_win_mask(i);
+		Bitboard own_in_mask = own & mask;
+		Bitboard opponent_in_mask = opponent & mask;
+		if (!opponent_in_mask) {
+			score += pgm_read_byte(&pattern_scores[count_pieces(own_in_mask)]);
+		} else if (!own_in_mask) {
+			score -= pgm_read_byte(
+					&pattern_scores[count_pieces(opponent_in_mask)]);
+		}
+	}
+	return score;
+}
+
+// Win and loss scores depend on the distance from the root, but the table
+// may be probed from a different ply. They are stored relative to the
+// position instead, and converted back when read.
+#define WIN_THRESHOLD (WIN_SCORE - 2 * NUM_SQUARES)
+
+static int16_t score_to_table(int16_t score, uint8_t ply) {
+	if (score >= WIN_THRESHOLD) {
+		return score + ply;
+	} else if (score <= -WIN_THRESHOLD) {
+		return score - ply;
+	}
+	return score;
+}
+
+static int16_t score_from_table(int16_t score, uint8_t ply) {
+	if (score >= WIN_THRESHOLD) {
+		return score - ply;
+	} else if (score <= -WIN_THRESHOLD) {
+		return score + ply;
+	}
+	return score;
+}
+
+// moves 'move' to the front of the list, if it is in it
+static void order_first(MoveCode* moves, uint8_t num_moves, MoveCode move) {
+	for (uint8_t i = 0; i < num_moves; i++) {
+		if (moves[i] == move) {
+			MoveCode first = moves[i];
+			moves[i] = moves[0];
+			moves[0] = first;
+			return;
+		}
+	}
+}
+
+// negamax alpha-beta search of the position where 'player', who owns 'own',
+// is to move and 'hash' is the position's Zobrist hash. 'ply' is the
+// distance from the root. Returns 0 once the search has been aborted;
+// callers must check search_aborted.
+static int16_t search(uint8_t player, Bitboard own, Bitboard opponent,
+		uint8_t placed, uint32_t hash, uint8_t depth, int16_t alpha,
+		int16_t beta, uint8_t ply) {
+	// leaves are counted too, as most of the nodes in a search are leaves
+	if (--nodes_until_time_check == 0) {
+		nodes_until_time_check = NODES_PER_TIME_CHECK;
+		if (get_current_time() >= search_deadline) {
+			search_aborted = 1;
+		}
+	}
+	if (search_aborted) {
+		return 0;
+	}
+	if (depth == 0) {
+		return evaluate(own, opponent);
+	}
+
+	// a stored result that is deep enough may settle this position
+	// straight away, otherwise its best move is tried first
+	MoveCode tt_move = NO_MOVE;
+	TTEntry* entry = tt_probe(hash);
+	if (entry) {
+		if (entry->depth >= depth) {
+			int16_t score = score_from_table(entry->score, ply);
+			if (entry->bound == TT_EXACT ||
+					(entry->bound == TT_LOWER && score >= beta) ||
+					(entry->bound == TT_UPPER && score <= alpha)) {
+				return score;
+			}
+		}
+		tt_move = entry->best_move;
+	}
+
+	MoveCode moves[MAX_MOVES];
+	uint8_t num_moves = generate_moves(own, own | opponent, placed, moves);
+	if (num_moves == 0) {
+		// a blocked player can't move, which is no worse for them than
+		// any other quiet position
+		return evaluate(own, opponent);
+	}
+	if (tt_move != NO_MOVE) {
+		order_first(moves, num_moves, tt_move);
+	}
+	uint8_t next_placed = (placed < 2 * PIECES_PER_PLAYER) ? placed + 1 : placed;
+	uint8_t next_player = (player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+
+	int16_t original_alpha = alpha;
+	int16_t best_score = -INFINITE_SCORE;
+	uint8_t best_index = 0;
+	for (uint8_t i = 0; i < num_moves; i++) {
+		Bitboard next_own = apply_move(own, moves[i]);
+		int16_t score;
+		if (next_placed >= LAST_DROPS_START &&
+				pieces_win_through(next_own, move_to(moves[i]))) {
+			// nothing beats winning straight away
+			score = WIN_SCORE - (ply + 1);
+		} else {
+			score = -search(next_player, opponent, next_own, next_placed,
+					hash ^ move_hash_change(player, move_from(moves[i]),
+					move_to(moves[i])),
+					depth - 1, -beta, -alpha, ply + 1);
+			if (search_aborted) {
+				return 0;
+			}
+		}
+		if (score > best_score) {
+			best_score = score;
+			best_index = i;
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta) {
+					break;
+				}
+			}
+		}
+	}
+
+	uint8_t bound = TT_EXACT;
+	if (best_score <= original_alpha) {
+		bound = TT_UPPER;
+	} else if (best_score >= beta) {
+		bound = TT_LOWER;
+	}
+	tt_store(hash, depth, score_to_table(best_score, ply), bound,
+			moves[best_index]);
+	return best_score;
+}
+
+MoveCode ai_choose_move(void) {
+	uint8_t player = get_current_player();
+	Bitboard own = get_player_pieces(player);
+	Bitboard opponent = get_occupied_squares() ^ own;
+	uint8_t placed = get_pieces_placed();
+	uint8_t next_placed = (placed < 2 * PIECES_PER_PLAYER) ? placed + 1 : placed;
+	uint8_t next_player = (player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	uint32_t hash = get_position_hash();
+
+	if (placed < 2 * PIECES_PER_PLAYER) {
+		MoveCode move = book_move(get_player_pieces(PLAYER_1),
+				get_player_pieces(PLAYER_2));
+		if (move != NO_MOVE) {
+			return move;
+		}
+	}
+
+	MoveCode moves[MAX_MOVES];
+	uint8_t num_moves = generate_moves(own, own | opponent, placed, moves);
+	if (num_moves == 0) {
+		return NO_MOVE;
+	}
+	MoveCode best_move = moves[0];
+
+	search_deadline = get_current_time() + time_budget;
+	search_aborted = 0;
+	nodes_until_time_check = NODES_PER_TIME_CHECK;
+
+	for (uint8_t depth = 1; depth <= AI_MAX_DEPTH; depth++) {
+		int16_t alpha = -INFINITE_SCORE;
+		uint8_t best_index = NO_SQUARE;
+		for (uint8_t i = 0; i < num_moves; i++) {
+			Bitboard next_own = apply_move(own, moves[i]);
+			int16_t score;
+			if (next_placed >= LAST_DROPS_START &&
+					pieces_win_through(next_own, move_to(moves[i]))) {
+				score = WIN_SCORE - 1;
+			} else {
+				score = -search(next_player, opponent, next_own, next_placed,
+						hash ^ move_hash_change(player, move_from(moves[i]),
+						move_to(moves[i])), depth - 1, -INFINITE_SCORE, -alpha, 1);
+				if (search_aborted) {
+					break;
+				}
+			}
+			if (score > alpha) {
+				alpha = score;
+				best_index = i;
+			}
+		}
+
+		// Every move scored so far was fully searched at this depth, and
+		// the previous best was searched first, so even a cut-short
+		// iteration's best is at least as good as what we had. Move it to
+		// the front so the next iteration searches it first.
+		if (best_index != NO_SQUARE) {
+			best_move = moves[best_index];
+			moves[best_index] = moves[0];
+			moves[0] = best_move;
+		}
+		if (search_aborted || alpha >= WIN_SCORE - AI_MAX_DEPTH) {
+			// out of time, or a forced win has been found
+			break;
+		}
+	}
+	return best_move;
+}
+
+void ai_play_move(void) {
+	MoveCode move = ai_choose_move();
+	if (move == NO_MOVE) {
+		// Every piece is hemmed in. That isn't a loss in Teeko, so the
+		// turn passes to the opponent rather than leaving the game
+		// waiting for a move that can't come.
+		pass_turn();
+	} else {
+		play_move(move_from(move), move_to(move));
+	}
+}
@@ -0,0 +1,42 @@
+/*
+ * ai.h
+ *
+ * A computer opponent for Teeko. Moves are chosen with an alpha-beta search
+ * using iterative deepening, which is stopped once a time budget (measured
+ * with timer0) runs out. The best move found so far is always returned, so
+ * the time taken to move does not depend on the position.
+ */
+
+
+#ifndef AI_H_
+#define AI_H_
+
+#include <stdint.h>
+#include "game.h"
+
+// time budget used until ai_set_time_budget() is called (in milliseconds)
+#define AI_DEFAULT_TIME_BUDGET	200
+
+// deepest search (in plies) the iterative deepening will try
+#define AI_MAX_DEPTH			8
+
+// set or get how long (in milliseconds) the search may run for each move
+void ai_set_time_budget(uint16_t milliseconds);
+uint16_t ai_get_time_budget(void);
+
+// forget everything learnt about the previous game. Call this whenever a
+// new game is started.
+void ai_new_game(void);
+
+// searches the current game position and returns the best move found for
+// the active player within the time budget, or NO_MOVE if there are no
+// legal moves. Positions in the opening book are answered at once without
+// a search. timer0 must be running and the game must not be over.
+MoveCode ai_choose_move(void);
+
+// chooses a move for the active player and plays it, or passes the turn
+// if the active player has no legal move
+void ai_play_move(void);
+
+
+#endif /* AI_H_ */
@@ -0,0 +1,181 @@
+/*
+ * animation.c
+ *
+ * Animations are kept as a type plus the few values that type needs, and
+ * a step counter. animation_tick() counts down to the next step and
+ * performs it by updating the LED matrix framebuffer, which is then sent
+ * with the next display frame. Steps are skipped while a frame is being
+ * sent, since the framebuffer can't change then.
+ */
+
+#include "animation.h"
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#define ANIMATION_NONE		0
+#define ANIMATION_SCROLL	1
+#define ANIMATION_BLINK		2
+#define ANIMATION_SLIDE		3
+
+static volatile uint8_t animation_type;
+static uint8_t step_period;
+static uint8_t ms_until_step;
+static uint16_t step;
+
+// scrolling banners. Once a banner which doesn't repeat runs out, step
+// counts the blank columns scrolled in after it.
+static BannerSource banner_source;
+static uint8_t banner_repeat;
+static uint8_t banner_finished;
+
+// blinking pixels. Odd steps show the 'off' colour.
+static uint8_t blink_x[ANIMATION_MAX_BLINK_PIXELS];
+static uint8_t blink_y[ANIMATION_MAX_BLINK_PIXELS];
+static uint8_t blink_count;
+static PixelColour blink_on, blink_off;
+static uint8_t blink_steps;
+
+// sliding pieces
+static uint8_t slide_x, slide_y;
+static PixelColour slide_trail, slide_background;
+
+// A slide which is stopped early still has its trail cleared. Anything
+// drawn over the trail since (such as the cursor) is left alone.
+static void finish_slide(void) {
+	if (animation_type == ANIMATION_SLIDE &&
+			ledmatrix_get_pixel(slide_x, slide_y) == slide_trail) {
+		ledmatrix_update_pixel(slide_x, slide_y, slide_background);
+	}
+}
+
+// Start an animation of type 'type' whose first step is on the next tick.
+// The caller has set up that type's values with interrupts disabled.
+static void start_animation(uint8_t type, uint8_t step_ms) {
+	finish_slide();
+	animation_type = type;
+	step_period = step_ms;
+	ms_until_step = 1;
+	step = 0;
+}
+
+void animation_scroll(BannerSource source, uint8_t step_ms, uint8_t repeat) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	banner_source = source;
+	banner_repeat = repeat;
+	banner_finished = 0;
+	start_animation(ANIMATION_SCROLL, step_ms);
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void animation_blink(const uint8_t* x, const uint8_t* y, uint8_t count,
+		PixelColour on, PixelColour off, uint8_t times, uint8_t step_ms) {
+	if (count > ANIMATION_MAX_BLINK_PIXELS) {
+		count = ANIMATION_MAX_BLINK_PIXELS;
+	}
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	for (uint8_t i = 0; i < count; i++) {
+		blink_x[i] = x[i];
+		blink_y[i] = y[i];
+	}
+	blink_count = count;
+	blink_on = on;
+	blink_off = off;
+	blink_steps = 2 * times;
+	start_animation(ANIMATION_BLINK, step_ms);
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void animation_slide(uint8_t from_x, uint8_t from_y, uint8_t to_x,
+		uint8_t to_y, PixelColour colour, PixelColour trail,
+		PixelColour background, uint8_t step_ms) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	finish_slide();
+	ledmatrix_update_pixel(from_x, from_y, trail);
+	ledmatrix_update_pixel(to_x, to_y, colour);
+	slide_x = from_x;
+	slide_y = from_y;
+	slide_trail = trail;
+	slide_background = background;
+	start_animation(ANIMATION_SLIDE, step_ms);
+	ms_until_step = step_ms;
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void animation_stop(void) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	finish_slide();
+	animation_type = ANIMATION_NONE;
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+uint8_t animation_running(void) {
+	return animation_type != ANIMATION_NONE;
+}
+
+// Scroll the display left and draw the banner's next column on the right.
+// The shift blanks that column, so only its lit pixels need sending.
+static void scroll_step(void) {
+	MatrixColumn column;
+	ledmatrix_shift_display_left();
+	if (!banner_finished && !banner_source(step, column)) {
+		if (banner_repeat) {
+			step = 0;
+			if (!banner_source(0, column)) {
+				animation_type = ANIMATION_NONE;
+				return;
+			}
+		} else {
+			banner_finished = 1;
+			step = 0;
+		}
+	}
+	if (banner_finished) {
+		// the display is blank once the last column has scrolled off
+		if (step >= MATRIX_NUM_COLUMNS - 1) {
+			animation_type = ANIMATION_NONE;
+		}
+	} else {
+		ledmatrix_update_column(MATRIX_NUM_COLUMNS - 1, column);
+	}
+}
+
+static void blink_step(void) {
+	PixelColour colour = (step & 1) ? blink_off : blink_on;
+	if (step >= blink_steps) {
+		colour = blink_on;
+		animation_type = ANIMATION_NONE;
+	}
+	for (uint8_t i = 0; i < blink_count; i++) {
+		ledmatrix_update_pixel(blink_x[i], blink_y[i], colour);
+	}
+}
+
+void animation_tick(void) {
+	if (animation_type == ANIMATION_NONE || ledmatrix_sending_frame() ||
+			--ms_until_step) {
+		return;
+	}
+	ms_until_step = step_period;
+	if (animation_type == ANIMATION_SCROLL) {
+		scroll_step();
+	} else if (animation_type == ANIMATION_BLINK) {
+		blink_step();
+	} else {
+		finish_slide();
+		animation_type = ANIMATION_NONE;
+	}
+	step++;
+}
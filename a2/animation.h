@@ -0,0 +1,61 @@
+/*
+ * animation.h
+ *
+ * Animations on the LED matrix, stepped from the timer0 interrupt so the
+ * game carries on while they play. One animation runs at a time; starting
+ * another replaces it.
+ *
+ * Scrolling banners move the display with the matrix's own shift command
+ * and only draw the column which scrolls in, so each step costs a few SPI
+ * bytes rather than a whole display update.
+ */
+
+
+#ifndef ANIMATION_H_
+#define ANIMATION_H_
+
+#include <stdint.h>
+#include "ledmatrix.h"
+
+// Fills 'column' with column 'index' of a banner and returns 1, or returns
+// 0 if the banner has fewer columns. Called from the timer0 interrupt, so
+// it must be quick.
+typedef uint8_t (*BannerSource)(uint16_t index, MatrixColumn column);
+
+// most pixels animation_blink() can blink at once
+#define ANIMATION_MAX_BLINK_PIXELS 8
+
+// Scroll a banner in from the right, one column every 'step_ms'
+// milliseconds. If 'repeat' is set the banner starts again from its first
+// column once it runs out, otherwise the animation ends once it has
+// scrolled off the left of the display.
+void animation_scroll(BannerSource source, uint8_t step_ms, uint8_t repeat);
+
+// Blink 'count' pixels (given as matrix x and y coordinates) between the
+// colours 'on' and 'off' 'times' times, changing every 'step_ms'
+// milliseconds. The pixels are left showing 'on'.
+void animation_blink(const uint8_t* x, const uint8_t* y, uint8_t count,
+		PixelColour on, PixelColour off, uint8_t times, uint8_t step_ms);
+
+// Show a piece of colour 'colour' sliding from (from_x,from_y) to
+// (to_x,to_y): it is drawn at the destination at once with a trail of
+// colour 'trail' left where it came from, which becomes 'background'
+// after 'step_ms' milliseconds (unless something else, such as the
+// cursor, has been drawn there in the meantime).
+void animation_slide(uint8_t from_x, uint8_t from_y, uint8_t to_x,
+		uint8_t to_y, PixelColour colour, PixelColour trail,
+		PixelColour background, uint8_t step_ms);
+
+// stop any animation, leaving the display as it is (except that the trail
+// of a slide is cleared)
+void animation_stop(void);
+
+// returns 1 if an animation is playing, 0 otherwise
+uint8_t animation_running(void);
+
+// Moves the animation on when its next step is due. This must be called
+// from the timer0 interrupt handler (i.e. every millisecond).
+void animation_tick(void);
+
+
+#endif /* ANIMATION_H_ */
@@ -0,0 +1,107 @@
+/*
+ * book.c
+ *
+ * Opening book lookup. Positions are looked up by their canonical form
+ * (see symmetry.h), so the book stores each symmetry class once and the
+ * move found is mapped back onto the real board.
+ *
+ * Each position has a key: the positions with the same number of pieces
+ * are numbered by the colex ranks of player 1's and player 2's pieces,
+ * after those with fewer pieces. The book is the sorted list of keys with
+ * one move (a square to drop on) each. It is split into blocks of
+ * BOOK_BLOCK_SIZE positions; the first key of every block is kept in a
+ * table which is binary searched. Within a block the first position is
+ * stored as just its square and each following one as the number
+ * (key gap - 1) << BOOK_SQUARE_BITS | square, written 7 bits a byte, low
+ * bits first, with the top bit set on all but the last byte. The AVR has
+ * no divide instruction, so keys are ranked with additions and the
+ * entries are unpacked with shifts and masks.
+ */
+
+#include "book.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "symmetry.h"
+#include "book_data.h"
+
+// Returns the colex rank of a set of squares among the sets of the same
+// size (the sum of choose(square, i) for the i-th square of the set), and
+// sets '*num_sets' to the number of such sets. choose(square, i) is
+// stepped along the board by Pascal's rule, so only additions are needed.
+// None of the numbers exceed choose(NUM_SQUARES, PIECES_PER_PLAYER).
+static uint16_t rank_pieces(Bitboard pieces, uint16_t* num_sets) {
+	// binomials[i] is choose(square, i)
+	uint16_t binomials[PIECES_PER_PLAYER + 1] = {1};
+	uint16_t rank = 0;
+	uint8_t count = 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if (pieces & ((Bitboard)1 << square)) {
+			rank += binomials[++count];
+		}
+		for (uint8_t i = PIECES_PER_PLAYER; i > 0; i--) {
+			binomials[i] += binomials[i - 1];
+		}
+	}
+	*num_sets = binomials[count];
+	return rank;
+}
+
+static uint32_t book_key(Bitboard p1_pieces, Bitboard p2_pieces,
+		uint8_t placed) {
+	uint16_t p1_sets, p2_sets;
+	uint16_t p1_rank = rank_pieces(p1_pieces, &p1_sets);
+	uint16_t p2_rank = rank_pieces(p2_pieces, &p2_sets);
+	return pgm_read_dword(&book_level_base[placed]) +
+			(uint32_t)p1_rank * p2_sets + p2_rank;
+}
+
+MoveCode book_move(Bitboard p1_pieces, Bitboard p2_pieces) {
+	uint8_t placed = 0;
+	for (Bitboard pieces = p1_pieces | p2_pieces; pieces; pieces &= pieces - 1) {
+		placed++;
+	}
+	if (placed > BOOK_MAX_PLACED) {
+		return NO_MOVE;
+	}
+	uint8_t symmetry = canonicalise_position(&p1_pieces, &p2_pieces);
+	uint32_t key = book_key(p1_pieces, p2_pieces, placed);
+
+	// find the last block starting at or before the key
+	uint16_t low = 0, high = BOOK_NUM_BLOCKS;
+	while (high - low > 1) {
+		uint16_t middle = (low + high) / 2;
+		if (pgm_read_dword(&book_block_keys[middle]) <= key) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	uint32_t entry_key = pgm_read_dword(&book_block_keys[low]);
+	if (entry_key > key) {
+		return NO_MOVE;
+	}
+	const uint8_t* data = &book_data[pgm_read_word(&book_block_offsets[low])];
+	const uint8_t* end = (low + 1 < BOOK_NUM_BLOCKS) ?
+			&book_data[pgm_read_word(&book_block_offsets[low + 1])] :
+			&book_data[sizeof(book_data)];
+	uint8_t square = pgm_read_byte(data++);
+	while (entry_key < key) {
+		if (data == end) {
+			return NO_MOVE;
+		}
+		uint32_t value = 0;
+		uint8_t shift = 0;
+		uint8_t byte;
+		do {
+			byte = pgm_read_byte(data++);
+			value |= (uint32_t)(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+		entry_key += (value >> BOOK_SQUARE_BITS) + 1;
+		square = value & ((1 << BOOK_SQUARE_BITS) - 1);
+	}
+	if (entry_key != key) {
+		return NO_MOVE;
+	}
+	return DROP_MOVE(transform_square(inverse_symmetry(symmetry), square));
+}
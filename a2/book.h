@@ -0,0 +1,23 @@
+/*
+ * book.h
+ *
+ * Opening book for the drop phase. The book gives a perfect move for each
+ * early position the computer can meet while it has followed the book,
+ * playing either colour. It is generated from the solved game by
+ * host/teeko-book and kept compressed in flash.
+ */
+
+
+#ifndef BOOK_H_
+#define BOOK_H_
+
+#include <stdint.h>
+#include "teeko.h"
+
+// Returns the book move for the player to move in the drop phase position
+// where player 1 has the pieces 'p1_pieces' and player 2 'p2_pieces', or
+// NO_MOVE if the position is not in the book.
+MoveCode book_move(Bitboard p1_pieces, Bitboard p2_pieces);
+
+
+#endif /* BOOK_H_ */
@@ -0,0 +1,378 @@
+/*
+ * book_data.h
+ *
+ * Opening book for book.c, generated by host/teeko-book -p 6.
+ * Do not edit.
+ */
+
+#define BOOK_MAX_PLACED 6
+#define BOOK_BLOCK_SIZE 16
+#define BOOK_SQUARE_BITS 5
+#define BOOK_NUM_BLOCKS 147
+
+static const uint32_t book_level_base[BOOK_MAX_PLACED + 1] PROGMEM = {0, 1, 26, 651, 8151, 98151, 788151};
+
+// key of the first position in each block
+static const uint32_t book_block_keys[BOOK_NUM_BLOCKS] PROGMEM = {
+	0, 708, 1113, 1887, 2333, 3384,
+	28694, 30067, 30158, 30186, 30263, 98824,
+	101502, 102721, 103881, 105672, 106617, 108417,
+	110467, 112923, 114441, 119283, 126402, 134478,
+	135425, 136312, 138117, 139906, 141199, 142322,
+	143521, 144712, 145623, 146599, 148625, 149824,
+	151917, 154699, 156816, 158478, 160099, 163923,
+	164840, 166013, 168133, 169006, 169633, 170595,
+	172087, 174184, 178640, 179900, 181633, 183136,
+	197583, 198498, 199606, 200471, 202054, 220936,
+	222417, 223098, 236228, 237136, 240483, 243736,
+	245228, 246423, 247416, 250716, 254016, 256984,
+	258483, 260221, 262636, 263317, 264517, 268623,
+	271928, 275176, 276424, 277625, 280923, 289624,
+	293900, 306423, 375424, 421083, 442682, 447816,
+	451624, 467900, 1296529, 1296789, 1297035, 1297289,
+	1297634, 1297824, 1298188, 1298789, 1300102, 1322458,
+	1346310, 1346415, 1356337, 1356849, 1356962, 1357189,
+	1357611, 1357799, 1357920, 1358017, 1402438, 1436762,
+	1436880, 1437037, 1437160, 1437437, 1437651, 1437769,
+	1438853, 1439778, 1440337, 1621177, 1623069, 1623085,
+	1623117, 1623171, 1623190, 1623209, 1623515, 1623531,
+	1623547, 1623599, 1623620, 1623636, 1623652, 1623706,
+	1623744, 1623837, 1623989, 1624203, 1624222, 1624297,
+	1624382, 1624419, 1800498
+};
+
+static const uint16_t book_block_offsets[BOOK_NUM_BLOCKS] PROGMEM = {
+	0, 21, 51, 80, 106, 132, 160, 181, 200, 217,
+	237, 264, 293, 318, 342, 370, 396, 426, 455, 485,
+	514, 541, 573, 604, 631, 658, 686, 717, 747, 777,
+	807, 838, 865, 892, 921, 947, 976, 1006, 1034, 1064,
+	1093, 1124, 1154, 1183, 1213, 1243, 1268, 1292, 1319, 1343,
+	1372, 1398, 1426, 1455, 1484, 1510, 1541, 1569, 1597, 1630,
+	1658, 1684, 1714, 1741, 1768, 1800, 1826, 1852, 1878, 1907,
+	1937, 1966, 1994, 2022, 2052, 2078, 2106, 2133, 2163, 2193,
+	2217, 2245, 2276, 2309, 2338, 2373, 2408, 2435, 2463, 2494,
+	2525, 2556, 2582, 2605, 2631, 2658, 2683, 2710, 2740, 2769,
+	2798, 2827, 2852, 2876, 2901, 2925, 2948, 2972, 2996, 3024,
+	3048, 3070, 3100, 3126, 3146, 3163, 3184, 3209, 3232, 3254,
+	3281, 3306, 3331, 3358, 3377, 3393, 3409, 3429, 3445, 3461,
+	3478, 3494, 3510, 3527, 3544, 3560, 3576, 3593, 3611, 3631,
+	3650, 3668, 3684, 3702, 3723, 3741, 3768
+};
+
+static const uint8_t book_data[3770] PROGMEM = {
+	0x0C, 0x06, 0x0C, 0x07, 0x6C, 0x0C, 0x87, 0x01, 0x87, 0x4E, 0x07, 0x07,
+	0x6D, 0x02, 0xE2, 0x50, 0xA2, 0x01, 0xC1, 0x04, 0x0C, 0x00, 0x80, 0x01,
+	0xC1, 0x04, 0xA7, 0x01, 0x82, 0x06, 0xE7, 0x0A, 0xC6, 0x20, 0xEC, 0x04,
+	0x86, 0x01, 0x86, 0x06, 0x87, 0x05, 0x66, 0x92, 0x06, 0x80, 0x06, 0xE0,
+	0x04, 0x80, 0x01, 0x08, 0x8D, 0x05, 0x6D, 0xE1, 0x0A, 0xB0, 0x01, 0x80,
+	0x06, 0x91, 0x06, 0xC0, 0x12, 0x85, 0x06, 0xA6, 0x25, 0x87, 0x06, 0xD1,
+	0x2B, 0x86, 0x24, 0x91, 0x07, 0x08, 0x87, 0x05, 0x06, 0xC0, 0x12, 0x10,
+	0xE6, 0x05, 0x12, 0xE6, 0x05, 0x06, 0xE0, 0x18, 0x87, 0x05, 0x72, 0xC0,
+	0x12, 0x92, 0x06, 0x88, 0x06, 0xF2, 0x0A, 0x0B, 0xB1, 0x01, 0x00, 0x60,
+	0x20, 0x60, 0xD1, 0x03, 0x6D, 0xA7, 0x01, 0xB2, 0x16, 0xB2, 0x01, 0xD1,
+	0x05, 0xA6, 0x01, 0x8C, 0x5C, 0x06, 0x8A, 0x06, 0xC7, 0x4A, 0xE7, 0x2B,
+	0x07, 0x66, 0xEB, 0x18, 0x86, 0x06, 0xA7, 0x3D, 0x66, 0xE7, 0x18, 0xA7,
+	0x9B, 0x03, 0xC1, 0x85, 0x2D, 0x00, 0x60, 0x05, 0x80, 0x06, 0xAA, 0x02,
+	0xA0, 0x0C, 0xC0, 0x03, 0x16, 0xA0, 0x0D, 0xE0, 0x04, 0x91, 0x05, 0xB1,
+	0xBB, 0x02, 0x0B, 0x0B, 0x11, 0x11, 0x31, 0x71, 0x11, 0x08, 0x11, 0x11,
+	0x11, 0x11, 0x10, 0x11, 0x11, 0xB1, 0x06, 0x11, 0x0B, 0x11, 0x11, 0xB1,
+	0x01, 0x11, 0x12, 0x11, 0x11, 0xB1, 0x0B, 0x11, 0x0B, 0x11, 0x11, 0xD1,
+	0x02, 0x11, 0x06, 0x11, 0x11, 0x11, 0x11, 0x31, 0x11, 0x11, 0x11, 0x31,
+	0x11, 0x11, 0x0B, 0x08, 0x06, 0xAD, 0x03, 0xF1, 0x03, 0x11, 0x91, 0x05,
+	0x11, 0x0B, 0x11, 0x11, 0xF1, 0x02, 0x31, 0x31, 0x11, 0x06, 0x11, 0x11,
+	0xF1, 0x02, 0x31, 0x43, 0x03, 0x06, 0xA6, 0x03, 0xA3, 0xD5, 0x84, 0x01,
+	0xE4, 0x3C, 0xC7, 0x0C, 0x82, 0x01, 0xCB, 0x3C, 0x81, 0x02, 0x81, 0x0B,
+	0x01, 0xE4, 0x3D, 0x84, 0x0B, 0xC3, 0x3E, 0xA8, 0x02, 0x67, 0x66, 0x87,
+	0x08, 0x91, 0x01, 0xCB, 0x3C, 0xC8, 0x02, 0xAB, 0x0B, 0xE7, 0xE8, 0x02,
+	0xC6, 0x0C, 0x67, 0xF1, 0x3C, 0x0B, 0x8B, 0x05, 0x0D, 0x4B, 0x83, 0x3D,
+	0x83, 0x0B, 0xB2, 0x01, 0x0B, 0xC7, 0x3C, 0xCB, 0x08, 0x8B, 0x05, 0x11,
+	0x4B, 0xE0, 0x48, 0x72, 0x80, 0x3F, 0x00, 0x32, 0x0B, 0xA2, 0x3F, 0xE1,
+	0x01, 0xEB, 0x03, 0x87, 0x05, 0x6B, 0xC7, 0x3F, 0x62, 0x92, 0x09, 0x11,
+	0xAD, 0x40, 0x66, 0x92, 0x09, 0x0B, 0x00, 0x86, 0x01, 0x87, 0x08, 0x72,
+	0xE5, 0x49, 0x85, 0x18, 0xED, 0x33, 0xED, 0x16, 0xE3, 0x26, 0x87, 0x0B,
+	0xD1, 0x4C, 0x10, 0xCD, 0x16, 0x82, 0x32, 0x20, 0xB0, 0x01, 0x01, 0x60,
+	0x81, 0x0A, 0x60, 0x70, 0x83, 0x41, 0xD2, 0x0C, 0x6B, 0xCD, 0x12, 0xA7,
+	0x29, 0xC2, 0x08, 0xD1, 0x01, 0x92, 0x03, 0x6B, 0xC1, 0x39, 0xA0, 0x02,
+	0x01, 0xCD, 0x01, 0x92, 0x03, 0x6B, 0xE0, 0x3B, 0xA0, 0x09, 0xAD, 0x01,
+	0xEC, 0x02, 0x6B, 0xE2, 0x8F, 0x01, 0xC1, 0x3F, 0x81, 0x0B, 0xCD, 0x01,
+	0x81, 0x49, 0xF0, 0x01, 0x83, 0x41, 0x01, 0xF2, 0x04, 0x6B, 0xC3, 0x38,
+	0xC3, 0x0C, 0xE8, 0x0F, 0xE3, 0x2D, 0xE8, 0x1C, 0xF0, 0x03, 0xA6, 0x36,
+	0xA6, 0x14, 0xE2, 0x29, 0xA1, 0x0D, 0xA8, 0x0F, 0xA2, 0x3A, 0x20, 0x02,
+	0xEB, 0x1C, 0xE2, 0x8E, 0x02, 0xC1, 0x08, 0x8B, 0x06, 0xE8, 0x0D, 0xA2,
+	0x3A, 0xB2, 0x01, 0xA1, 0x49, 0xB2, 0x01, 0xF0, 0x12, 0xA1, 0x36, 0x61,
+	0x32, 0xC0, 0x40, 0xC1, 0x08, 0x12, 0x86, 0x17, 0xA1, 0x33, 0x88, 0x0F,
+	0x8D, 0x08, 0x82, 0x32, 0x82, 0x01, 0xC1, 0x49, 0x81, 0x01, 0x81, 0x13,
+	0xA2, 0x37, 0x02, 0x50, 0x80, 0x40, 0xE1, 0x09, 0xD2, 0x03, 0x0B, 0xCD,
+	0x12, 0x88, 0x32, 0x81, 0xB5, 0x06, 0xB0, 0x02, 0xCB, 0x02, 0x6B, 0x0D,
+	0xD2, 0x49, 0x80, 0x3F, 0x80, 0x0B, 0x32, 0x0B, 0x80, 0x4A, 0x32, 0xF2,
+	0x4A, 0x11, 0x91, 0x3C, 0x6D, 0xF1, 0x15, 0x82, 0x32, 0xD1, 0x01, 0xE1,
+	0x3D, 0x81, 0x0B, 0xC0, 0x01, 0x87, 0xDF, 0x01, 0xD1, 0x01, 0x86, 0xC0,
+	0x03, 0xB2, 0x01, 0x46, 0xE9, 0x49, 0xE2, 0xAD, 0x06, 0x0B, 0xD0, 0x05,
+	0x2B, 0xE7, 0x11, 0xF2, 0x37, 0x30, 0xA7, 0x12, 0xF2, 0x37, 0x0B, 0xD0,
+	0x12, 0xA1, 0xC3, 0x04, 0xF0, 0x01, 0xA7, 0x12, 0xA1, 0xAD, 0x03, 0xB0,
+	0x14, 0xE3, 0x97, 0x06, 0x08, 0xAB, 0x0B, 0xE3, 0x3D, 0xA8, 0x01, 0xB0,
+	0x08, 0x83, 0x01, 0xB2, 0x01, 0x87, 0x01, 0xC7, 0x3B, 0x61, 0x91, 0x0D,
+	0x10, 0x47, 0xAC, 0x11, 0x80, 0x37, 0x72, 0x10, 0x47, 0xAC, 0x11, 0xA0,
+	0x2C, 0x28, 0xB0, 0x08, 0x80, 0x02, 0x70, 0x8C, 0x12, 0x87, 0x2B, 0xC8,
+	0x01, 0xE6, 0x01, 0xB0, 0x06, 0xE7, 0x03, 0xA7, 0x3F, 0x66, 0x10, 0xD2,
+	0x02, 0x11, 0x67, 0xA8, 0x3E, 0x60, 0x66, 0xB0, 0x06, 0xEB, 0x02, 0x80,
+	0x40, 0x86, 0x01, 0xB0, 0x06, 0xD1, 0x01, 0xAD, 0x01, 0x8C, 0x12, 0xE1,
+	0x94, 0x02, 0x01, 0xB2, 0x01, 0x30, 0x8C, 0x12, 0xE1, 0x2E, 0xE1, 0x04,
+	0xB0, 0x01, 0x81, 0x01, 0xB2, 0x01, 0x81, 0xD4, 0x01, 0x81, 0x0B, 0x81,
+	0x48, 0xC1, 0x02, 0xF0, 0x01, 0x8C, 0x12, 0xE3, 0x2E, 0x01, 0xC1, 0x02,
+	0xF2, 0x04, 0x67, 0xA2, 0x83, 0x01, 0x61, 0x8D, 0x0E, 0xC8, 0x0D, 0xC2,
+	0x37, 0xC2, 0x02, 0xB2, 0x01, 0x8D, 0x01, 0xC8, 0x0D, 0xC3, 0x37, 0xB0,
+	0x01, 0xC8, 0x11, 0x10, 0xC1, 0x33, 0xC0, 0x03, 0x70, 0xA8, 0x0E, 0xD0,
+	0x03, 0xE0, 0x2D, 0xE1, 0x05, 0xB0, 0x01, 0xCF, 0x11, 0x86, 0x08, 0xA1,
+	0x2F, 0xC1, 0x02, 0xA8, 0x10, 0xC5, 0x37, 0xC1, 0x02, 0x00, 0x88, 0x0F,
+	0xE1, 0x2E, 0x90, 0x0A, 0xE7, 0x03, 0xF1, 0x15, 0xEC, 0x30, 0xD2, 0x02,
+	0x87, 0x01, 0xE6, 0x15, 0xE0, 0x27, 0x2C, 0xB0, 0x08, 0x80, 0x02, 0xC6,
+	0x17, 0xF0, 0x30, 0x00, 0x90, 0x13, 0xA6, 0x04, 0xF0, 0x30, 0xD1, 0x11,
+	0x86, 0x08, 0xA1, 0x2F, 0xB0, 0x01, 0x81, 0x01, 0xB2, 0x01, 0x86, 0x17,
+	0xA5, 0x2F, 0xC1, 0x02, 0xD1, 0x01, 0xF1, 0x16, 0xA5, 0x2F, 0x10, 0xA0,
+	0x03, 0x91, 0x0E, 0x86, 0x08, 0xC1, 0x26, 0xC2, 0x01, 0xB0, 0x08, 0xC7,
+	0x02, 0x30, 0x47, 0xF0, 0x46, 0xD2, 0x02, 0x30, 0x47, 0xA8, 0x3E, 0xB0,
+	0x08, 0x12, 0x0B, 0x10, 0xD0, 0x47, 0xD2, 0x02, 0x30, 0x90, 0x12, 0xE2,
+	0x2E, 0xB0, 0x06, 0xD2, 0x02, 0xCD, 0x06, 0x6D, 0xE1, 0x3E, 0xB0, 0x01,
+	0x81, 0x01, 0xB2, 0x01, 0x07, 0xC1, 0x33, 0xC1, 0x02, 0xF0, 0x01, 0x81,
+	0x46, 0xB0, 0x01, 0x80, 0x02, 0x32, 0xE8, 0x0E, 0x90, 0x39, 0x80, 0x02,
+	0x32, 0x86, 0x17, 0xC7, 0x86, 0x02, 0x61, 0x91, 0x0D, 0x10, 0xE2, 0x48,
+	0x20, 0x81, 0x3F, 0x60, 0x81, 0x0A, 0x60, 0x70, 0xA1, 0x3D, 0xC8, 0x01,
+	0xE6, 0x01, 0xC7, 0x09, 0xD1, 0x16, 0xA7, 0x29, 0x66, 0xC2, 0x07, 0x11,
+	0xE6, 0x16, 0xE1, 0x26, 0xA0, 0x02, 0x66, 0xB1, 0x09, 0x0D, 0xC6, 0x16,
+	0x80, 0x29, 0x86, 0x01, 0xC1, 0x07, 0x31, 0x86, 0x18, 0x81, 0x93, 0x02,
+	0xB2, 0x01, 0xC1, 0x41, 0x01, 0xB2, 0x01, 0x86, 0x17, 0x81, 0x93, 0x02,
+	0x00, 0xD0, 0x01, 0x83, 0x41, 0xE0, 0x07, 0xD2, 0x04, 0x68, 0xD1, 0x12,
+	0xC2, 0x70, 0xB0, 0x0E, 0xE2, 0x48, 0xE1, 0x4A, 0xF0, 0x01, 0x00, 0xAF,
+	0x36, 0x6F, 0x80, 0x41, 0xC1, 0x08, 0xC6, 0x18, 0x82, 0x7D, 0x02, 0x81,
+	0x3F, 0x91, 0x24, 0x82, 0x32, 0xB2, 0x01, 0x86, 0x17, 0xE1, 0x26, 0x60,
+	0x80, 0x0B, 0x06, 0x81, 0x32, 0x60, 0xC6, 0x17, 0xC0, 0x42, 0x86, 0x08,
+	0x81, 0x32, 0xB2, 0x01, 0x86, 0x17, 0xA2, 0x32, 0xB1, 0x01, 0xF1, 0x16,
+	0x82, 0x32, 0x80, 0x02, 0xA6, 0x16, 0xC1, 0x26, 0x08, 0xD0, 0x0B, 0xE2,
+	0x48, 0xF0, 0x01, 0xC1, 0x3D, 0xED, 0x0C, 0x10, 0xE1, 0x48, 0xF0, 0x01,
+	0x86, 0x41, 0xC7, 0x09, 0x80, 0x06, 0x60, 0xA6, 0x0F, 0x81, 0x32, 0xF0,
+	0x01, 0x07, 0xC0, 0x36, 0xD0, 0x01, 0xE1, 0x48, 0x61, 0x70, 0xE1, 0x49,
+	0xC6, 0x17, 0x81, 0x93, 0x02, 0xF0, 0x01, 0xE7, 0x03, 0x86, 0x3D, 0xC8,
+	0x0D, 0xC6, 0x12, 0x92, 0x99, 0x02, 0xC6, 0x12, 0x12, 0x30, 0xE8, 0x03,
+	0xC3, 0x38, 0x82, 0x0B, 0xC9, 0x15, 0xA2, 0x02, 0x83, 0x27, 0xA1, 0x0B,
+	0xC1, 0x06, 0xA1, 0x0D, 0xA9, 0x01, 0xA1, 0x02, 0xA3, 0x28, 0xA5, 0x08,
+	0xC6, 0x05, 0x00, 0xC3, 0x0B, 0xC0, 0x01, 0x82, 0x2B, 0x81, 0x02, 0xA1,
+	0x08, 0x41, 0xE1, 0x04, 0xA1, 0x0E, 0x90, 0x02, 0xA1, 0x02, 0xA2, 0x28,
+	0xA2, 0x08, 0x62, 0x82, 0x13, 0xC8, 0x7A, 0x01, 0xA1, 0x10, 0xD2, 0x04,
+	0xA2, 0xD7, 0x02, 0x82, 0x0E, 0xC1, 0x3C, 0xA1, 0x08, 0xC6, 0x05, 0xC0,
+	0x02, 0xC3, 0x0B, 0xC0, 0x01, 0xA1, 0x2C, 0x60, 0xA1, 0x07, 0x60, 0xC1,
+	0x04, 0x00, 0xA2, 0x0D, 0x60, 0x81, 0x2D, 0xA6, 0x03, 0xE1, 0x04, 0xC1,
+	0x05, 0xD3, 0x01, 0xC0, 0x0A, 0xE1, 0x01, 0xD0, 0x02, 0xD2, 0x35, 0xD2,
+	0x15, 0xCD, 0x02, 0xA8, 0x01, 0xC2, 0x26, 0x02, 0xC7, 0x05, 0xA7, 0x0E,
+	0xE0, 0x05, 0x60, 0x28, 0x70, 0xC1, 0x25, 0xE0, 0x10, 0xA0, 0x0D, 0x80,
+	0x04, 0x60, 0x28, 0x70, 0xC0, 0x26, 0xA0, 0x08, 0x02, 0xA7, 0x0E, 0xE0,
+	0x04, 0x71, 0x28, 0x70, 0xC0, 0x35, 0x12, 0xA0, 0x0A, 0xD2, 0x04, 0x80,
+	0x03, 0x71, 0x28, 0x70, 0xA2, 0x6F, 0xA1, 0x1F, 0x01, 0x52, 0x29, 0xA1,
+	0x02, 0xE2, 0x30, 0xC6, 0x05, 0xA8, 0x0E, 0xA2, 0x01, 0x20, 0x45, 0x29,
+	0xF1, 0x3B, 0x81, 0x0D, 0x85, 0x01, 0xE2, 0xC9, 0x01, 0xC6, 0x05, 0x06,
+	0xA0, 0x01, 0x20, 0x40, 0x29, 0xCB, 0x49, 0x40, 0x2B, 0xC0, 0x03, 0x2B,
+	0x6B, 0xC1, 0x9C, 0x03, 0xA2, 0x08, 0xC3, 0x05, 0x80, 0x0C, 0x66, 0x01,
+	0x46, 0xF2, 0x03, 0xC0, 0x44, 0x61, 0x20, 0xD2, 0x04, 0x81, 0xEC, 0x03,
+	0xA2, 0x08, 0x60, 0x81, 0x13, 0xC8, 0xA6, 0x03, 0xA0, 0x0F, 0xE0, 0x3A,
+	0xA1, 0x08, 0xC1, 0x05, 0x00, 0xC6, 0x0C, 0x40, 0x77, 0xE6, 0x2E, 0xB0,
+	0x06, 0xF3, 0x05, 0x60, 0xC0, 0x09, 0xC0, 0x03, 0x77, 0xE2, 0xC9, 0x01,
+	0xA1, 0x08, 0x82, 0x0D, 0x26, 0x40, 0x09, 0xF0, 0x34, 0xE0, 0x06, 0xA0,
+	0x09, 0x66, 0x31, 0xA0, 0x02, 0x92, 0x02, 0x81, 0x2B, 0xA0, 0x08, 0x30,
+	0x80, 0x05, 0xC0, 0x01, 0xC2, 0x0C, 0x40, 0xA2, 0x8E, 0x02, 0x07, 0x27,
+	0x00, 0xE0, 0x0B, 0xC6, 0x01, 0x95, 0x02, 0xA6, 0x2E, 0x80, 0x0C, 0x00,
+	0xC0, 0x0A, 0x91, 0x01, 0xF0, 0x03, 0xC2, 0xD0, 0x01, 0x86, 0x0C, 0xE6,
+	0x03, 0xC2, 0x3A, 0x00, 0xA0, 0x0A, 0xA0, 0x01, 0xE2, 0x03, 0x52, 0x8D,
+	0x2B, 0x80, 0x0E, 0x20, 0x00, 0xE0, 0x0B, 0xC6, 0x01, 0x80, 0x02, 0xC1,
+	0xA4, 0x1B, 0xC8, 0x01, 0x87, 0x0B, 0x87, 0x01, 0x08, 0xA0, 0x3B, 0x32,
+	0x87, 0x01, 0xC8, 0x0D, 0x80, 0x30, 0x28, 0xB0, 0x08, 0xD2, 0x02, 0x86,
+	0x01, 0xC8, 0x0D, 0xA0, 0x3B, 0x32, 0x30, 0x46, 0xC8, 0x0D, 0x10, 0xE6,
+	0x2E, 0x80, 0x02, 0x90, 0x04, 0xD2, 0x02, 0x86, 0x01, 0xCF, 0x0D, 0xC1,
+	0x37, 0xC1, 0x02, 0xB2, 0x01, 0x87, 0x01, 0xC8, 0x0D, 0xC1, 0x37, 0xC1,
+	0x02, 0xC0, 0x02, 0xC8, 0x0D, 0x01, 0xC0, 0x03, 0x32, 0x80, 0x01, 0xC8,
+	0x0D, 0x90, 0x39, 0xE0, 0x01, 0x52, 0x86, 0x01, 0xD1, 0x0D, 0x86, 0x08,
+	0xF0, 0x30, 0x82, 0x02, 0x32, 0x86, 0x01, 0xC8, 0x0D, 0x01, 0xC8, 0x01,
+	0xD0, 0x0B, 0x21, 0xC1, 0x06, 0x88, 0x07, 0xA2, 0x3A, 0x60, 0xA0, 0x01,
+	0xC0, 0x06, 0xA1, 0x36, 0xD2, 0x0C, 0x60, 0xA1, 0xDE, 0x01, 0xB2, 0x01,
+	0x60, 0x00, 0xE0, 0x41, 0x80, 0x02, 0xC0, 0x06, 0x88, 0x07, 0xA1, 0x3A,
+	0xA0, 0x02, 0xF2, 0xDF, 0x01, 0xC0, 0x07, 0xC0, 0xAE, 0x06, 0x00, 0xEB,
+	0x13, 0x81, 0xA6, 0x1B, 0xC8, 0x01, 0xC2, 0x08, 0xC7, 0x03, 0x08, 0x12,
+	0x8C, 0x0F, 0x2C, 0x82, 0x35, 0xB2, 0x02, 0x87, 0x01, 0xE8, 0x01, 0xB0,
+	0x0F, 0x30, 0xA8, 0x2C, 0xB0, 0x08, 0x0C, 0x90, 0x15, 0xE1, 0xC9, 0x01,
+	0xC2, 0x01, 0x01, 0xF0, 0x01, 0xC8, 0x02, 0x12, 0x8C, 0x0F, 0x2C, 0xA1,
+	0x33, 0xC2, 0x01, 0x61, 0xC8, 0x04, 0x12, 0xA8, 0x0B, 0xD2, 0x03, 0x30,
+	0xA1, 0x33, 0x88, 0x13, 0x10, 0xD0, 0xBC, 0x07, 0xC2, 0x02, 0x88, 0x01,
+	0xEF, 0xB1, 0x06, 0xC0, 0x06, 0xA0, 0x0D, 0x87, 0xA6, 0x0A, 0x91, 0x0E,
+	0xCB, 0x49, 0x72, 0x11, 0x6D, 0xE0, 0x3D, 0x80, 0x0B, 0x4B, 0x0D, 0xEC,
+	0x01, 0xC8, 0x0B, 0xEB, 0x2E, 0xC8, 0x01, 0xE6, 0x01, 0x87, 0x09, 0x8D,
+	0x01, 0xA7, 0x3F, 0x66, 0x92, 0x09, 0x11, 0xA0, 0x40, 0x66, 0x92, 0x09,
+	0x0B, 0x0C, 0xD1, 0x0B, 0xA7, 0x31, 0x86, 0x01, 0x87, 0x08, 0x72, 0x11,
+	0x6D, 0xA1, 0xEC, 0x02, 0x92, 0x09, 0x67, 0x91, 0xAB, 0x02, 0x10, 0x83,
+	0x41, 0xD2, 0x0C, 0x6B, 0x11, 0xAB, 0xE6, 0x02, 0x6B, 0xCD, 0x01, 0xA0,
+	0x3F, 0xC1, 0x08, 0xB2, 0x01, 0x86, 0x17, 0xCB, 0xBC, 0x01, 0x90, 0x0A,
+	0xED, 0x03, 0xD2, 0x49, 0x8D, 0x01, 0xE0, 0x3D, 0x80, 0x0B, 0xCD, 0x01,
+	0x12, 0xD1, 0x0B, 0xA0, 0x3B, 0x51, 0x6D, 0xD2, 0x49, 0x8D, 0x01, 0xCB,
+	0x0D, 0xF2, 0x3B, 0x71, 0x0D, 0xF1, 0x49, 0x6D, 0xD1, 0x0D, 0xA1, 0x3A,
+	0x80, 0x02, 0x0D, 0xCB, 0x3C, 0xC2, 0x01, 0x87, 0x0B, 0x30, 0x4D, 0xF1,
+	0x15, 0xD2, 0x33, 0x30, 0xC6, 0x16, 0xD2, 0x33, 0x0B, 0x10, 0xCC, 0x02,
+	0xC8, 0x0B, 0x86, 0x08, 0x12, 0x11, 0x10, 0x4D, 0xE6, 0x15, 0xA2, 0x2A,
+	0x92, 0x09, 0xCD, 0x06, 0x6D, 0xA6, 0x0F, 0xD2, 0x33, 0x6B, 0xE7, 0x11,
+	0x86, 0x04, 0x90, 0x34, 0xA8, 0x0E, 0x11, 0x81, 0x32, 0x61, 0x32, 0x86,
+	0x17, 0x80, 0x33, 0x32, 0x8D, 0x01, 0xE6, 0x15, 0xA6, 0xD6, 0x02, 0xB0,
+	0x06, 0xD2, 0x02, 0x80, 0x20, 0x10, 0xD0, 0x88, 0x02, 0xE7, 0x03, 0x06,
+	0xE0, 0x08, 0x00, 0xD0, 0x27, 0xD2, 0x02, 0x86, 0x17, 0xE0, 0x08, 0x10,
+	0x86, 0xCD, 0x02, 0x92, 0x09, 0x86, 0x17, 0x80, 0x09, 0xC6, 0xA2, 0x02,
+	0x80, 0x09, 0xB2, 0x2A, 0x30, 0x06, 0x80, 0x09, 0xC0, 0xCA, 0x02, 0xA1,
+	0x08, 0xC7, 0x05, 0xA6, 0x0E, 0xC6, 0x30, 0xB3, 0x0C, 0xC0, 0x0A, 0xC5,
+	0x04, 0xA0, 0x0C, 0x60, 0x20, 0x61, 0xE0, 0x97, 0x02, 0x66, 0x00, 0xD2,
+	0x04, 0x82, 0x0B, 0x60, 0x22, 0x62, 0xA1, 0x1D, 0xA2, 0x08, 0xC0, 0x05,
+	0xA1, 0x0E, 0xEB, 0xC2, 0x01, 0xC8, 0x01, 0xA5, 0x0C, 0xC8, 0x0D, 0xA0,
+	0x3B, 0x32, 0x08, 0x80, 0x30, 0xD2, 0x0B, 0xE8, 0x0E, 0xA0, 0x3B, 0x51,
+	0x70, 0xC8, 0x0D, 0xC6, 0x32, 0x80, 0x02, 0xF2, 0x06, 0xEB, 0x0E, 0xF2,
+	0x3B, 0x60, 0xE8, 0x58, 0xA1, 0x3A, 0x00, 0xA8, 0x0F, 0x80, 0x3B, 0xF0,
+	0x01, 0xCB, 0x0D, 0xEB, 0xDA, 0x02, 0xC8, 0x01, 0xA7, 0x0C, 0x92, 0x02,
+	0xD1, 0x13, 0x08, 0xB2, 0x33, 0x92, 0x13, 0xE6, 0x03, 0x08, 0x86, 0x2A,
+	0x0C, 0x12, 0xA8, 0x0B, 0x86, 0x08, 0x08, 0xD1, 0x33, 0x10, 0x45, 0x87,
+	0x03, 0xC6, 0x12, 0x08, 0x86, 0x2A, 0x87, 0x02, 0xF2, 0x06, 0xA7, 0x04,
+	0xC6, 0x12, 0x08, 0xF0, 0x33, 0x27, 0xB2, 0x02, 0xF2, 0x4A, 0xA8, 0x0B,
+	0x91, 0x08, 0x08, 0xE1, 0x31, 0xE0, 0x03, 0xC6, 0x14, 0x08, 0xE0, 0x32,
+	0xC5, 0x01, 0x80, 0x01, 0xC6, 0x14, 0x0C, 0x88, 0xE1, 0x06, 0xE6, 0x01,
+	0x87, 0x09, 0x11, 0x92, 0x03, 0xCD, 0x13, 0xA7, 0x29, 0x66, 0x92, 0x09,
+	0x11, 0x92, 0x03, 0xC6, 0x13, 0xA8, 0x28, 0x60, 0x66, 0x12, 0x0B, 0x92,
+	0x03, 0xC6, 0x13, 0x8C, 0x29, 0x86, 0x01, 0x87, 0x08, 0x72, 0x11, 0x8C,
+	0x03, 0xC6, 0x13, 0xA1, 0xD6, 0x02, 0x92, 0x09, 0xB2, 0x03, 0xC6, 0x13,
+	0xA3, 0xD6, 0x02, 0x0D, 0x92, 0x02, 0x6B, 0xCD, 0x12, 0xA0, 0xA0, 0x03,
+	0x92, 0x0A, 0xB2, 0x03, 0xC6, 0x13, 0xAC, 0xBE, 0x01, 0xB1, 0x0B, 0x8B,
+	0x04, 0xB2, 0x46, 0x11, 0x6D, 0x8B, 0x03, 0xA7, 0x0E, 0x00, 0x2C, 0xC0,
+	0x0A, 0x52, 0x6D, 0x8B, 0x03, 0xB6, 0x0E, 0x86, 0x04, 0x80, 0x33, 0x51,
+	0x6D, 0x8B, 0x03, 0xA7, 0x0E, 0xF2, 0x37, 0x11, 0x6D, 0x11, 0x8B, 0x04,
+	0x80, 0x47, 0x2D, 0x8B, 0x03, 0xB2, 0x0E, 0x86, 0x04, 0xA8, 0x28, 0xB1,
+	0x0B, 0x07, 0xEB, 0x03, 0xB2, 0x46, 0x2D, 0xEB, 0x03, 0x8B, 0x3B, 0xB2,
+	0x0B, 0x0D, 0xEB, 0x03, 0xC6, 0x12, 0xF1, 0x33, 0x07, 0xB2, 0x95, 0x01,
+	0xAB, 0x04, 0xA7, 0x0E, 0xAD, 0x38, 0x4D, 0x8B, 0x03, 0xE1, 0x45, 0xEB,
+	0x04, 0xC6, 0x12, 0xA6, 0xA1, 0x03, 0xAC, 0x06, 0x12, 0xB2, 0x03, 0xC6,
+	0x13, 0xE0, 0x08, 0x00, 0x86, 0xC4, 0x05, 0x92, 0x09, 0xB2, 0x03, 0xC6,
+	0x13, 0x80, 0x0E, 0x86, 0x8A, 0x06, 0xE0, 0x06, 0xA8, 0x05, 0xA8, 0x0F,
+	0xE8, 0xB9, 0x04, 0x87, 0x0B, 0x11, 0x80, 0x4A, 0x32, 0x80, 0x3F, 0x28,
+	0x92, 0x0B, 0x86, 0x17, 0xE0, 0x95, 0x02, 0x81, 0x49, 0x32, 0xC8, 0xB6,
+	0x03, 0x87, 0x0B, 0x11, 0x92, 0x03, 0xE8, 0x13, 0xB2, 0x33, 0x12, 0x88,
+	0x04, 0x88, 0x28, 0xE6, 0x01, 0x92, 0x09, 0x80, 0xAD, 0x02, 0x92, 0x02,
+	0x86, 0xF7, 0x06, 0x92, 0x09, 0xB2, 0x03, 0xC6, 0x13, 0x80, 0x09, 0x88,
+	0xCF, 0x09, 0xB0, 0x08, 0xCB, 0x02, 0xC6, 0xCE, 0x04, 0x12, 0xB2, 0x03,
+	0xE0, 0x1C, 0xE0, 0xE8, 0x0F, 0x86, 0xAE, 0x04, 0xB0, 0x06, 0xD2, 0x02,
+	0xB2, 0x03, 0xC0, 0x1C, 0xA6, 0xC4, 0x05, 0x92, 0x09, 0xA0, 0x20, 0x86,
+	0xFC, 0x1C, 0x92, 0x09, 0xB2, 0x03, 0xE0, 0x1C, 0x11, 0x10, 0x86, 0x41,
+	0x87, 0x09, 0x11, 0xCB, 0x0E, 0xEB, 0x8A, 0x57, 0xC8, 0x01, 0xB1, 0x0B,
+	0x10, 0x4D, 0xD2, 0x49, 0x11, 0x8B, 0x04, 0xE6, 0x43, 0xCB, 0x02, 0x08,
+	0xC8, 0xE7, 0x28, 0xE6, 0x01, 0xD2, 0x0C, 0x87, 0x3D, 0x66, 0x92, 0x09,
+	0x11, 0x92, 0x03, 0x85, 0x0B, 0x92, 0x05, 0xC8, 0x2B, 0x6D, 0x66, 0xAB,
+	0x09, 0x92, 0x03, 0x06, 0x92, 0x05, 0xA7, 0x2C, 0x86, 0x01, 0x87, 0x08,
+	0x72, 0xAC, 0x03, 0x86, 0x0B, 0x92, 0x05, 0xC3, 0xD0, 0x05, 0xD2, 0x0C,
+	0x6B, 0x80, 0xB3, 0x03, 0xD2, 0x0D, 0x86, 0x0B, 0x92, 0x05, 0x06, 0xD2,
+	0xF5, 0x03, 0xC6, 0x0E, 0x0B, 0xC1, 0x91, 0x02, 0xB0, 0x08, 0x87, 0x03,
+	0x86, 0x0E, 0x92, 0x05, 0x91, 0x03, 0xD2, 0x33, 0x2D, 0x85, 0x0E, 0x92,
+	0x05, 0x86, 0x03, 0xA5, 0x28, 0x0B, 0x0D, 0x86, 0x0E, 0x92, 0x05, 0x86,
+	0x03, 0xD2, 0x33, 0x27, 0x86, 0x0E, 0xE6, 0xFC, 0x11, 0xA8, 0x0C, 0xC0,
+	0x0A, 0xC8, 0x8D, 0x0C, 0xB0, 0x08, 0x92, 0x06, 0xB2, 0x47, 0xC5, 0x0E,
+	0x0C, 0x52, 0xA8, 0x03, 0x88, 0x28, 0xE6, 0x01, 0xE6, 0x17, 0x92, 0x96,
+	0x2E, 0x11, 0xA5, 0x0E, 0xE4, 0xBF, 0xA3, 0x0C, 0x43, 0x63, 0x26, 0x01,
+	0x23, 0x68, 0x06, 0x66, 0xE6, 0x05, 0x61, 0xE3, 0x07, 0x2B, 0x01, 0x01,
+	0x01, 0xE1, 0x01, 0xE1, 0x01, 0xE3, 0x05, 0x63, 0xA3, 0x06, 0xD3, 0x16,
+	0x61, 0x01, 0xED, 0x0B, 0x61, 0xA1, 0x06, 0x83, 0x0F, 0x2B, 0x01, 0x01,
+	0x01, 0xE1, 0x01, 0xE1, 0x01, 0x81, 0x02, 0xA3, 0x02, 0xC1, 0x05, 0x81,
+	0x03, 0x85, 0x07, 0x0A, 0x01, 0x01, 0x05, 0xE1, 0x01, 0xE1, 0x01, 0x81,
+	0x02, 0xA3, 0x02, 0xC1, 0x05, 0x81, 0x03, 0xA1, 0x03, 0xA6, 0x07, 0x66,
+	0xA1, 0x06, 0xE1, 0x0E, 0xC5, 0x03, 0x0D, 0x61, 0xA1, 0x06, 0xE1, 0x0E,
+	0xC1, 0x03, 0xED, 0x0B, 0x61, 0xA1, 0x06, 0xE1, 0x0E, 0xC1, 0x03, 0xA3,
+	0x10, 0x2A, 0x01, 0x01, 0x01, 0xE1, 0x01, 0x01, 0x81, 0x02, 0xA3, 0x02,
+	0xC1, 0x05, 0x81, 0x03, 0xA1, 0x03, 0xC1, 0x03, 0xE1, 0x03, 0x81, 0x04,
+	0xA1, 0x04, 0xA3, 0x08, 0x2A, 0x03, 0x01, 0x03, 0xE3, 0x01, 0x06, 0x81,
+	0x02, 0xA3, 0x02, 0xC1, 0x05, 0x81, 0x03, 0xA1, 0x03, 0xC3, 0x03, 0xEB,
+	0x03, 0x81, 0x04, 0xA1, 0x04, 0xC1, 0x04, 0xC6, 0x08, 0x61, 0xA1, 0x06,
+	0xE1, 0x0E, 0xC1, 0x03, 0x01, 0xE1, 0x04, 0xED, 0x08, 0x66, 0xA1, 0x06,
+	0xE1, 0x0E, 0xC1, 0x03, 0xA1, 0x11, 0xE1, 0x04, 0xAD, 0x0E, 0x61, 0xA1,
+	0x06, 0xE1, 0x0E, 0xC1, 0x03, 0xA1, 0x11, 0xE1, 0x04, 0x04, 0x43, 0x63,
+	0x83, 0x01, 0xC3, 0x06, 0xE3, 0x06, 0xE3, 0x08, 0x83, 0x0B, 0x83, 0x1E,
+	0xA3, 0x13, 0xC3, 0x16, 0x83, 0x1A, 0xE3, 0x1D, 0xE3, 0x21, 0x83, 0x26,
+	0xC3, 0x2A, 0x03, 0xA3, 0x34, 0xC3, 0x39, 0x83, 0x3F, 0x81, 0x83, 0x29,
+	0x00, 0x24, 0x03, 0x89, 0x07, 0xE8, 0x06, 0xE0, 0x08, 0x80, 0x0B, 0x83,
+	0x1E, 0xA3, 0x13, 0xC0, 0x16, 0x80, 0x1A, 0x00, 0xE0, 0x21, 0x80, 0x26,
+	0xC0, 0x2A, 0xA0, 0x2F, 0xA0, 0x34, 0xC0, 0x39, 0x80, 0x3F, 0xE6, 0xF6,
+	0x2B, 0x32, 0x06, 0x32, 0x06, 0x6D, 0x06, 0x6D, 0x0D, 0xF1, 0x02, 0x11,
+	0xC6, 0x01, 0x06, 0xE6, 0x01, 0x06, 0x8D, 0x02, 0x0D, 0xB1, 0x05, 0x06,
+	0xE6, 0x02, 0x06, 0x86, 0x03, 0x06, 0xAD, 0x03, 0x06, 0xC6, 0x03, 0x06,
+	0xE6, 0x03, 0x06, 0x86, 0x04, 0x06, 0xA6, 0x04, 0x06, 0xC6, 0x04, 0x06,
+	0xC6, 0x3E, 0x06, 0xE6, 0x3E, 0x06, 0xAB, 0x9B, 0x12, 0x0B, 0x4B, 0x4B,
+	0x6B, 0xAB, 0x04, 0xEB, 0x0A, 0x92, 0x0B, 0x8B, 0x1E, 0xAB, 0x13, 0xCB,
+	0x16, 0xEB, 0x10, 0x0B, 0x4B, 0x4B, 0x6B, 0xAB, 0x04, 0x0B, 0x8B, 0x02,
+	0xA5, 0x02, 0xCB, 0x05, 0x8B, 0x03, 0xAB, 0x03, 0xAB, 0x03, 0x0B, 0x0B,
+	0x0B, 0x0B, 0x4B, 0x0B, 0x4B, 0x0B, 0x8B, 0x04, 0x0B, 0xCB, 0x01, 0x0B,
+	0xEB, 0x01, 0x0B, 0x92, 0x02, 0x0D, 0xAB, 0x05, 0x0B, 0xEB, 0x02, 0x0B,
+	0x8B, 0x03, 0x0B, 0xAB, 0x03, 0x0B, 0xCB, 0x0C, 0x0B, 0xEB, 0x03, 0x0B,
+	0xEB, 0x0C, 0xEB, 0x14, 0xEB, 0x03, 0x0B, 0xAB, 0x11, 0xEB, 0x14, 0xEB,
+	0x03, 0x0B, 0xEB, 0x0C, 0x0B, 0x4B, 0x4B, 0x6B, 0x0B, 0xEB, 0x01, 0x8B,
+	0x02, 0xA5, 0x02, 0xCB, 0x05, 0x8B, 0x03, 0xAB, 0x03, 0xCB, 0x03, 0xEB,
+	0x03, 0x0B, 0xEB, 0x03, 0xAB, 0x04, 0xCB, 0x04, 0xCB, 0x04, 0x0B, 0x4B,
+	0x0B, 0x6B, 0xAB, 0x04, 0xEB, 0x01, 0x8B, 0x02, 0xB2, 0x02, 0xCB, 0x05,
+	0x8B, 0x03, 0xAB, 0x03, 0x8B, 0x03, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x4B,
+	0x0B, 0x0B, 0x0D, 0x2B, 0x0B, 0x0B, 0x4B, 0x0B, 0x8B, 0x03, 0x4B, 0xAB,
+	0x03, 0x6B, 0xAB, 0x03, 0x8B, 0x01, 0xAB, 0x03, 0xAB, 0x01, 0x0B, 0xCB,
+	0x0A, 0xEB, 0x14, 0xEB, 0x03, 0x0B, 0x8B, 0x12, 0x8B, 0x05, 0xAB, 0x03,
+	0xEB, 0x0A, 0xEB, 0x14, 0xEB, 0x03, 0x0B, 0x8B, 0x12, 0x8B, 0x05, 0xAB,
+	0x03, 0xC1, 0xE2, 0x55, 0x00, 0x2F, 0x00, 0x20, 0xE0, 0x01, 0xE0, 0x01,
+	0xE0, 0x22, 0xA0, 0x13, 0xE0, 0x70, 0x80, 0x26, 0xC0, 0x87, 0x02, 0xA6,
+	0xA7, 0x3F, 0x26, 0x06, 0x26, 0x06, 0x06, 0x06, 0x8A, 0x02, 0x03, 0xC6,
+	0x08, 0x06, 0xC6, 0x06, 0x06, 0xC6, 0x08, 0x06, 0x06, 0x06, 0x06, 0x06,
+	0x06, 0x06, 0x06, 0x66, 0x06, 0x52, 0x12, 0x12, 0x86, 0x02, 0x26, 0x06,
+	0x06, 0x06, 0x46, 0x26, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x46,
+	0x66, 0x8F, 0x01, 0x86, 0x03, 0xE6, 0x01, 0x86, 0x02, 0x26, 0x06, 0x06,
+	0x06, 0x86, 0x07, 0x06, 0x06, 0x26, 0x06, 0x06, 0x06, 0xE6, 0x06, 0xA6,
+	0x04, 0x46, 0xA6, 0x05, 0xE6, 0x01, 0xC6, 0x02, 0x86, 0x07, 0x26, 0x86,
+	0x03, 0x86, 0x0F, 0x86, 0x07, 0x06, 0xA6, 0x07, 0x86, 0x03, 0x86, 0x07,
+	0x86, 0x03, 0xA6, 0x0B, 0x06, 0x86, 0x0B, 0x06, 0x06, 0x86, 0x07, 0x06,
+	0x06, 0x06, 0x06, 0x06, 0x10, 0x26, 0x06, 0x06, 0xE6, 0x03, 0xA6, 0x03,
+	0xC6, 0x03, 0xC6, 0x01, 0x86, 0x01, 0x66, 0x06, 0x66, 0x06, 0xC6, 0x0A,
+	0x26, 0x06, 0x06, 0x06, 0xE6, 0x06, 0x86, 0x07, 0x86, 0x07, 0xA6, 0x07,
+	0x66, 0x86, 0x02, 0xA6, 0x07, 0xC6, 0x0D, 0xE6, 0x13, 0xE6, 0xB1, 0x01,
+	0x06, 0x86, 0x0B, 0x06, 0x06, 0x06, 0xE6, 0x15, 0x8D, 0x3D, 0x0D, 0x0D,
+	0x0D, 0x0D, 0x0D, 0xC9, 0x01, 0xCD, 0x03, 0xCF, 0x2B, 0xAF, 0x13, 0xCD,
+	0x16, 0x8D, 0x1A, 0xAD, 0x1C, 0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x09,
+	0x2D, 0xAF, 0x08, 0x89, 0x03, 0xAD, 0x03, 0xCD, 0x03, 0x8D, 0x0E, 0xCD,
+	0x17, 0xAD, 0x0E, 0xCD, 0x17, 0xED, 0x12, 0x0D, 0xCD, 0x17, 0xCD, 0x17,
+	0xCD, 0x1C, 0xCD, 0x17, 0xED, 0x21, 0xCD, 0x17, 0xAD, 0x27, 0xCD, 0x17,
+	0x91, 0xBB, 0xDF, 0x02, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0xEA, 0xD3, 0x03, 0x0A, 0x0A, 0x2A, 0x0A, 0x8A, 0x01, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x2A, 0x4A, 0x6A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x4A, 0xAA, 0x01,
+	0x0A, 0xCA, 0x02, 0x0A, 0x0A, 0xEA, 0x01, 0xAA, 0x01, 0x0E, 0x0E, 0x2E,
+	0x4E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x6E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E,
+	0xCA, 0x48, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0E, 0x0E,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x8A, 0x09, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0xAA, 0x01, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x2E, 0x0E, 0x0E,
+	0xAA, 0x09, 0x0A, 0x0A, 0x0A, 0x0A, 0x2A, 0x0A, 0xCA, 0x01, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x4A, 0xEA, 0x01, 0x0A, 0x2A, 0x4A, 0x6A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x2A, 0x8A, 0x01, 0x0A, 0xAA, 0x01,
+	0x0A, 0xCA, 0x01, 0x6E, 0x6E, 0xEA, 0x0D, 0x0A, 0x0A, 0x0A, 0x0A, 0xCA,
+	0x02, 0x0A, 0x0A, 0x0A, 0x0A, 0x8A, 0x1D, 0x0A, 0x0A, 0x0A, 0x0A, 0xCA,
+	0x02, 0x0A, 0x0A, 0xEA, 0x21, 0x0A, 0x0A, 0xEA, 0x0F, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x2A, 0x0A, 0x0A, 0x0A, 0x0A, 0x4A, 0x0A, 0x0A,
+	0x0A, 0x0A, 0x6A, 0x0A, 0x0A, 0x0A, 0x0A, 0x8E, 0x01, 0x0E, 0x0E, 0x0E,
+	0x0E, 0xAA, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x8A, 0x03, 0x0A,
+	0x0A, 0xAA, 0x03, 0x0A, 0x0A, 0xCA, 0x03, 0x0A, 0x0A, 0xEA, 0x03, 0x0A,
+	0x0A, 0xEA, 0x03, 0x0A, 0x2A, 0x4A, 0x0A, 0x0A, 0x0A, 0x2A, 0x0A, 0x0A,
+	0x4A, 0x0A, 0x0A, 0xCA, 0x02, 0x0A, 0x0A, 0xAA, 0x01, 0x0A, 0x0A, 0xEA,
+	0x10, 0xCA, 0x03, 0x8A, 0x08, 0xAA, 0x04, 0xCA, 0x04, 0xCA, 0x04, 0x2A,
+	0x4A, 0xAA, 0x01, 0x8A, 0x01, 0xE1, 0xC2, 0xD7, 0x02, 0x02, 0x00, 0x40,
+	0x00, 0x00
+};
@@ -7,21 +7,40 @@
 #include "buttons.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include "timer0.h"
 
 // Global variable to keep track of the last button state so that we 
 // can detect changes when an interrupt fires. The lower 4 bits (0 to 3)
 // will correspond to the last state of port B pins 0 to 3.
 static volatile uint8_t last_button_state;
 
-// Our button queue. button_queue[0] is always the head of the queue. If we
-// take something off the queue we just move everything else along. We don't
-// use a circular buffer since it is usually expected that the queue is very
-// short. In most uses it will never have more than 1 element at a time.
-// This button queue can be changed by the interrupt handler below so we should
-// turn off interrupts if we're changing the queue outside the handler.
-#define BUTTON_QUEUE_SIZE 4
-static volatile uint8_t button_queue[BUTTON_QUEUE_SIZE];
-static volatile int8_t queue_length;
+// Our button event queue, a circular buffer which the interrupt handler
+// below adds to at queue_head and button_get_event() takes from at
+// queue_tail. As with the serial buffers, each index is only written by
+// one side and the indices run freely (wrapping at 256), so the queue size
+// must be a power of two and head - tail is the number of events waiting.
+// Neither side needs to turn interrupts off.
+#define BUTTON_QUEUE_SIZE 16
+#define BUTTON_QUEUE_MASK (BUTTON_QUEUE_SIZE - 1)
+static volatile ButtonEvent button_queue[BUTTON_QUEUE_SIZE];
+static volatile uint8_t queue_head;
+static volatile uint8_t queue_tail;
+static volatile uint16_t events_dropped;
+
+// The button last pressed (or NO_BUTTON_PUSHED), and when it next repeats
+static int8_t held_button;
+static uint16_t next_repeat_time;
+static uint16_t repeat_delay;
+static uint16_t repeat_interval;
+
+static ButtonStats stats;
+// when the push last returned by button_pushed() happened, and whether it
+// is still to be reported handled
+static uint16_t push_time;
+static uint8_t push_pending;
+// the running average latency times 8, kept with shifts rather than as a
+// total and a count, which would need a long division to report
+static uint32_t average_latency_8;
 
 // Setup interrupt if any of pins B0 to B3 change. We do this
 // using a pin change interrupt. These pins correspond to pin
@@ -39,34 +58,110 @@ void init_button_interrupts(void) {
 	// the relevant bits in the mask register (see datasheet page 78)
 	PCMSK1 |= (1<<PCINT8)|(1<<PCINT9)|(1<<PCINT10)|(1<<PCINT11);	
 	
-	// Empty the button push queue
-	queue_length = 0;
+	// Empty the button event queue. Buttons already held down are only
+	// reported once released.
+	last_button_state = PINB & 0x0F;
+	queue_head = queue_tail = 0;
+	events_dropped = 0;
+	held_button = NO_BUTTON_PUSHED;
+	push_pending = 0;
+	average_latency_8 = 0;
+	stats = (ButtonStats){0};
+	button_set_repeat(BUTTON_REPEAT_DELAY, BUTTON_REPEAT_INTERVAL);
 }
 
-int8_t button_pushed(void) {
-	int8_t return_value = NO_BUTTON_PUSHED;	// Assume no button pushed
-	if(queue_length > 0) {
-		// Remove the first element off the queue and move all the other
-		// entries closer to the front of the queue. We turn off interrupts (if on)
-		// before we make any changes to the queue. If interrupts were on
-		// we turn them back on when done.
-		return_value = button_queue[0];
-		
-		// Save whether interrupts were enabled and turn them off
-		int8_t interrupts_were_enabled = bit_is_set(SREG, SREG_I);
-		cli();
-		
-		for(uint8_t i = 1; i < queue_length; i++) {
-			button_queue[i-1] = button_queue[i];
+uint8_t button_get_event(ButtonEvent* event) {
+	// The time is read after the head so that every event before the head
+	// is stamped no later than it
+	uint8_t tail = queue_tail;
+	uint8_t head = queue_head;
+	uint16_t now = get_current_time();
+	
+	if(tail != head) {
+		*event = button_queue[tail & BUTTON_QUEUE_MASK];
+		queue_tail = tail + 1;
+		if(event->type == BUTTON_PRESS) {
+			held_button = event->button;
+			next_repeat_time = event->time + repeat_delay;
+		} else if(event->button == held_button) {
+			held_button = NO_BUTTON_PUSHED;
+		}
+	} else if(held_button != NO_BUTTON_PUSHED && repeat_delay &&
+			(last_button_state & (1 << held_button)) &&
+			(int16_t)(now - next_repeat_time) >= 0) {
+		// Still held (the release may have been lost to a full queue, so
+		// the pin is checked too). If the game loop has fallen more than a
+		// repeat behind, the missed repeats are skipped rather than sent
+		// all at once.
+		event->button = held_button;
+		event->type = BUTTON_REPEAT;
+		event->time = next_repeat_time;
+		next_repeat_time += repeat_interval;
+		if((int16_t)(now - next_repeat_time) >= 0) {
+			next_repeat_time = now + repeat_interval;
 		}
-		queue_length--;
-		
-		if(interrupts_were_enabled) {
-			// Turn them back on again
-			sei();
+	} else {
+		return 0;
+	}
+	stats.events++;
+	return 1;
+}
+
+int8_t button_pushed(void) {
+	ButtonEvent event;
+	while(button_get_event(&event)) {
+		if(event.type != BUTTON_RELEASE) {
+			push_time = event.time;
+			push_pending = 1;
+			return event.button;
 		}
 	}
-	return return_value;
+	return NO_BUTTON_PUSHED;
+}
+
+void button_event_handled(void) {
+	if(!push_pending) {
+		return;
+	}
+	push_pending = 0;
+	uint16_t latency = (uint16_t)get_current_time() - push_time;
+	stats.handled++;
+	stats.last_latency = latency;
+	if(latency > stats.max_latency) {
+		stats.max_latency = latency;
+	}
+	// the first latency starts the average off
+	if(stats.handled == 1) {
+		average_latency_8 = (uint32_t)latency << 3;
+	} else {
+		average_latency_8 += latency - (average_latency_8 >> 3);
+	}
+	stats.average_latency = average_latency_8 >> 3;
+}
+
+void button_clear_events(void) {
+	queue_tail = queue_head;
+	held_button = NO_BUTTON_PUSHED;
+	push_pending = 0;
+}
+
+void button_set_repeat(uint16_t delay, uint16_t interval) {
+	repeat_delay = delay;
+	repeat_interval = (interval == 0) ? 1 : interval;
+}
+
+void button_get_repeat(uint16_t* delay, uint16_t* interval) {
+	*delay = repeat_delay;
+	*interval = repeat_interval;
+}
+
+void button_get_stats(ButtonStats* button_stats) {
+	*button_stats = stats;
+	// The interrupt handler may change the count between reading its two
+	// bytes, so read it until the same value is seen twice
+	do {
+		button_stats->dropped = events_dropped;
+	} while(button_stats->dropped != events_dropped);
 }
 
 // Interrupt handler for a change on buttons
@@ -74,22 +169,28 @@ ISR(PCINT1_vect) {
 	// Get the current state of the buttons. We'll compare this with
 	// the last state to see what has changed.
 	uint8_t button_state = PINB & 0x0F;
+	uint8_t changed = button_state ^ last_button_state;
+	uint16_t now = get_current_time();
 	
 	// Iterate over all the buttons and see which ones have changed.
-	// Any button pushes are added to the queue of button pushes (if
-	// there is space). We ignore button releases so we're just looking
-	// for a transition from 0 in the last_button_state bit to a 1 in the 
-	// button_state.
+	// Each press (a 0 to 1 transition) and release is added to the queue
+	// if there is space, and counted as dropped if not.
 	for(uint8_t pin = 0; pin < NUM_BUTTONS; pin++) {
-		if(queue_length < BUTTON_QUEUE_SIZE && 
-				(button_state & (1 << pin)) && 
-				!(last_button_state & (1 << pin))) {
-			// Add the button push to the queue (and update the
-			// length of the queue
-			button_queue[queue_length++] = pin;
+		if(!(changed & (1 << pin))) {
+			continue;
+		}
+		uint8_t head = queue_head;
+		if((uint8_t)(head - queue_tail) == BUTTON_QUEUE_SIZE) {
+			events_dropped++;
+			continue;
 		}
+		volatile ButtonEvent* event = &button_queue[head & BUTTON_QUEUE_MASK];
+		event->button = pin;
+		event->type = (button_state & (1 << pin)) ? BUTTON_PRESS : BUTTON_RELEASE;
+		event->time = now;
+		queue_head = head + 1;
 	}
 	
 	// Remember this button state
 	last_button_state = button_state;
-}
\ No newline at end of file
+}
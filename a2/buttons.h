@@ -4,7 +4,9 @@
  * Author: Peter Sutton
  *
  * We assume four push buttons (B0 to B3) are connected to pins B0 to B3. We configure
- * pin change interrupts on these pins.
+ * pin change interrupts on these pins. Each press and release is queued as an
+ * event stamped with the timer0 time it happened, and a button held down
+ * repeats once the repeat delay has passed (see button_set_repeat()).
  */ 
 
 
@@ -21,19 +23,75 @@
 
 #define NUM_BUTTONS 4
 
+// Default hold-to-repeat timing in milliseconds: how long a button must be
+// held before it repeats, then how often it repeats.
+#define BUTTON_REPEAT_DELAY 400
+#define BUTTON_REPEAT_INTERVAL 100
+
+// button event types
+#define BUTTON_PRESS 0
+#define BUTTON_RELEASE 1
+#define BUTTON_REPEAT 2		// the button is still held down
+
+typedef struct {
+	uint8_t button;		// 0 to 3
+	uint8_t type;		// BUTTON_PRESS, BUTTON_RELEASE or BUTTON_REPEAT
+	uint16_t time;		// low 16 bits of get_current_time() when the
+						// button changed, or when the repeat was due
+} ButtonEvent;
+
+// Button statistics. The latency of a press or repeat is the time from the
+// button changing (or the repeat falling due) to the game reporting it
+// handled with button_event_handled(), which the game does once the cursor
+// has been redrawn. The LED matrix shows it at its next frame.
+typedef struct {
+	uint16_t events;			// events taken from the queue
+	uint16_t dropped;			// presses and releases lost to a full queue
+	uint16_t handled;			// presses and repeats reported handled
+	uint16_t last_latency;		// ms
+	uint16_t max_latency;		// ms
+	uint16_t average_latency;	// ms, a running average which gives each
+								// new latency a weight of 1/8
+} ButtonStats;
+
 /* Set up pin change interrupts on pins B0 to B3.
  * It is assumed that global interrupts are off when this function is called
  * and are enabled sometime after this function is called.
  */
 void init_button_interrupts(void);
 
-/* Return the last button pushed (0 to 3) or -1 (NO_BUTTON_PUSHED) if 
- * there are no button pushes to return. (A small queue of button pushes
- * is kept. This function should be called frequently enough to
- * ensure the queue does not overflow. Excess button pushes are
- * discarded.)
+/* Take the oldest button event into *event. Returns 1 if there was one, or 0
+ * if there are none. Repeats of the button last pressed are made up here
+ * while it is held and no other events are waiting, so they never fill the
+ * queue and stop as soon as the release is taken. This function should be
+ * called frequently enough to ensure the queue (16 events) does not
+ * overflow. Excess events are discarded and counted.
+ */
+uint8_t button_get_event(ButtonEvent* event);
+
+/* Return the button (0 to 3) of the next press or repeat, skipping
+ * releases, or -1 (NO_BUTTON_PUSHED) if there are no button pushes to
+ * return.
  */
 int8_t button_pushed(void);
 
+/* Record that the push last returned by button_pushed() has been acted on
+ * (and drawn), for the latency statistics. Does nothing if it already has
+ * been, or if it was discarded by button_clear_events().
+ */
+void button_event_handled(void);
+
+/* Discard any waiting events, and stop a held button repeating until it is
+ * pressed again.
+ */
+void button_clear_events(void);
+
+/* Set how long (in ms) a button must be held before it repeats, and then how
+ * often it repeats. A delay of 0 turns repeating off.
+ */
+void button_set_repeat(uint16_t delay, uint16_t interval);
+void button_get_repeat(uint16_t* delay, uint16_t* interval);
+
+void button_get_stats(ButtonStats* button_stats);
 
-#endif /* BUTTONS_H_ */
\ No newline at end of file
+#endif /* BUTTONS_H_ */
@@ -9,93 +9,164 @@
 #include <avr/pgmspace.h>
 #include "pixel_colour.h"
 #include "ledmatrix.h"
+#include "animation.h"
+#include "font.h"
 
-// constant value used to display 'TEEKO' on launch
-static const uint8_t teeko_display[MATRIX_NUM_COLUMNS] = 
-		{65, 125, 65, 124, 84, 84, 125, 85, 85, 124, 16, 108, 57, 69, 69, 57};
+// Palettes for each theme, indexed by object and then the other PALETTE_
+// entries. The current palette is copied into RAM so it can be changed.
+static const PixelColour themes[NUM_THEMES][PALETTE_SIZE] PROGMEM = {
+	{	// THEME_STANDARD
+		MATRIX_COLOUR_EMPTY, MATRIX_COLOUR_P1, MATRIX_COLOUR_P2,
+		MATRIX_COLOUR_CURSOR, MATRIX_COLOUR_BG, MATRIX_COLOUR_P1_TRAIL,
+		MATRIX_COLOUR_P2_TRAIL
+	},
+	{	// THEME_COLOUR_BLIND: bright yellow against red
+		COLOUR_BLACK, 0xFF, COLOUR_RED, COLOUR_ORANGE, COLOUR_LIGHT_GREEN,
+		0x33, 0x03
+	}
+};
 
-void initialise_display(void) {
-	// start by clearing the LED matrix
-	ledmatrix_clear();
+static PixelColour palette[PALETTE_SIZE] = {
+	MATRIX_COLOUR_EMPTY, MATRIX_COLOUR_P1, MATRIX_COLOUR_P2,
+	MATRIX_COLOUR_CURSOR, MATRIX_COLOUR_BG, MATRIX_COLOUR_P1_TRAIL,
+	MATRIX_COLOUR_P2_TRAIL
+};
+static uint8_t theme = THEME_STANDARD;
 
-	// create an array with the background colour at every position
-	PixelColour col_colours[MATRIX_NUM_ROWS];
-	for (int row = 0; row < MATRIX_NUM_ROWS; row++) {
-		col_colours[row] = MATRIX_COLOUR_BG;
+void set_display_theme(uint8_t new_theme) {
+	if (new_theme >= NUM_THEMES) {
+		return;
 	}
+	theme = new_theme;
+	for (uint8_t i = 0; i < PALETTE_SIZE; i++) {
+		palette[i] = pgm_read_byte(&themes[theme][i]);
+	}
+}
 
-	// then add the bounds on the left
-	for (int x = 0; x < MATRIX_X_OFFSET; x++) {
-		ledmatrix_update_column(x, col_colours);
+uint8_t get_display_theme(void) {
+	return theme;
+}
+
+void set_palette_colour(uint8_t entry, PixelColour colour) {
+	if (entry < PALETTE_SIZE) {
+		palette[entry] = colour;
 	}
+}
 
-	// and add the bounds on the right
-	for (int x = MATRIX_X_OFFSET + WIDTH; x < MATRIX_NUM_COLUMNS; x++) {
-		ledmatrix_update_column(x, col_colours);
+// returns the colour used on the matrix for 'object'
+static PixelColour object_colour(uint8_t object) {
+	// anything unexpected will be the empty colour
+	if (object > CURSOR) {
+		object = EMPTY_SQUARE;
 	}
+	return palette[object];
+}
+
+// The board screen is composed in a frame buffer and then sent in one go.
+// The LED matrix module only sends the pixels which change, so repainting
+// it costs at most a single whole-display update.
+
+void initialise_display(void) {
+	// stop the splash screen (or anything else) animating
+	animation_stop();
 	
-	// create an array with the background colour at every position
-	PixelColour row_colours[MATRIX_NUM_COLUMNS];
-	for (int col = 0; col < MATRIX_NUM_COLUMNS; col++) {
-		row_colours[col] = MATRIX_COLOUR_BG;
+	// the board area is empty and everything around it is background
+	MatrixData frame;
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			if (x >= MATRIX_X_OFFSET && x < MATRIX_X_OFFSET + WIDTH &&
+					y >= MATRIX_Y_OFFSET && y < MATRIX_Y_OFFSET + HEIGHT) {
+				frame[x][y] = palette[EMPTY_SQUARE];
+			} else {
+				frame[x][y] = palette[PALETTE_BG];
+			}
+		}
 	}
+	ledmatrix_update_all(frame);
+}
 
-	// then add the bounds on the bottom
-	for (int y = 0; y < MATRIX_Y_OFFSET; y++) {
-		ledmatrix_update_row(y, row_colours);
-	}
+// splash banner, in the colours of the original title screen. The spaces
+// leave a gap before it repeats.
+static const char splash_text[] PROGMEM = TEXT_RED "T" TEXT_GREEN "E"
+		TEXT_RED "E" TEXT_GREEN "K" TEXT_RED "O" "   ";
 
-	// and add the bounds on the right
-	for (int y = MATRIX_Y_OFFSET + HEIGHT; y < MATRIX_NUM_ROWS; y++) {
-		ledmatrix_update_row(y, row_colours);
-	}
+// text and colour of the banner being scrolled
+static const char* banner_text;
+static PixelColour banner_colour;
+
+static uint8_t banner_column(uint16_t index, MatrixColumn column) {
+	return font_text_column(banner_text, banner_colour, index, column);
+}
+
+// scroll the text 'text' (a string in flash) across the display,
+// repeating until another animation starts
+static void scroll_banner(const char* text, PixelColour colour) {
+	animation_stop();
+	banner_text = text;
+	banner_colour = colour;
+	animation_scroll(banner_column, BANNER_STEP_MS, 1);
 }
 
 void start_display(void) {
-	PixelColour colour;
-	MatrixColumn column_colour_data;
-	uint8_t col_data;
-		
-	ledmatrix_clear(); // start by clearing the LED matrix
-	for (uint8_t col = 0; col < MATRIX_NUM_COLUMNS; col++) {
-		col_data = teeko_display[col];
-		// using the LSB as the colour determining bit, 1 is red, 0 is green
-		if (col_data & 0x01) {
-			colour = COLOUR_RED;
-		} else {
-			colour = COLOUR_GREEN;
-		}
-		// go through the top 7 bits (not the bottom one as that was our colour bit)
-		// and set any to be the correct colour
-		for(uint8_t i=7; i>=1; i--) {
-			// If the relevant font bit is set, we make this a coloured pixel, else blank
-			if(col_data & 0x80) {
-				column_colour_data[i] = colour;
-				} else {
-				column_colour_data[i] = 0;
-			}
-			col_data <<= 1;
+	// scroll 'TEEKO' across a blank display
+	ledmatrix_clear();
+	scroll_banner(splash_text, COLOUR_RED);
+}
+
+void update_square_colour(uint8_t x, uint8_t y, uint8_t object) {
+	// update the pixel at the given location with this object's colour
+	// the board is offset on the x axis to be centered on the LED matrix
+	ledmatrix_update_pixel(x + MATRIX_X_OFFSET, y + MATRIX_Y_OFFSET,
+			object_colour(object));
+}
+
+void update_square_colours(const uint8_t* x, const uint8_t* y,
+		const uint8_t* objects, uint8_t count) {
+	ledmatrix_begin_update();
+	for (uint8_t i = 0; i < count; i++) {
+		update_square_colour(x[i], y[i], objects[i]);
+	}
+	ledmatrix_end_update();
+}
+
+void update_board_colours(const uint8_t objects[HEIGHT][WIDTH]) {
+	ledmatrix_begin_update();
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		for (uint8_t x = 0; x < WIDTH; x++) {
+			update_square_colour(x, y, objects[y][x]);
 		}
-		column_colour_data[0] = 0;
-		ledmatrix_update_column(col, column_colour_data);
 	}
+	ledmatrix_end_update();
 }
 
-void update_square_colour(uint8_t x, uint8_t y, uint8_t object) {
-	// determine which colour corresponds to this object
-	PixelColour colour;
-	if (object == PLAYER_1) {
-		colour = MATRIX_COLOUR_P1;
-	} else if (object == PLAYER_2) {
-		colour = MATRIX_COLOUR_P2;
-	} else if (object == CURSOR) {
-		colour = MATRIX_COLOUR_CURSOR;
-	} else {
-		// anything unexpected will be black
-		colour = MATRIX_COLOUR_EMPTY;
+void slide_square_colour(uint8_t from_x, uint8_t from_y, uint8_t to_x,
+		uint8_t to_y, uint8_t object) {
+	PixelColour trail = (object == PLAYER_1) ? palette[PALETTE_P1_TRAIL] :
+			palette[PALETTE_P2_TRAIL];
+	animation_slide(from_x + MATRIX_X_OFFSET, from_y + MATRIX_Y_OFFSET,
+			to_x + MATRIX_X_OFFSET, to_y + MATRIX_Y_OFFSET,
+			object_colour(object), trail, palette[EMPTY_SQUARE], SLIDE_STEP_MS);
+}
+
+void blink_squares(const uint8_t* x, const uint8_t* y, uint8_t count,
+		uint8_t object) {
+	uint8_t matrix_x[ANIMATION_MAX_BLINK_PIXELS];
+	uint8_t matrix_y[ANIMATION_MAX_BLINK_PIXELS];
+	if (count > ANIMATION_MAX_BLINK_PIXELS) {
+		count = ANIMATION_MAX_BLINK_PIXELS;
+	}
+	for (uint8_t i = 0; i < count; i++) {
+		matrix_x[i] = x[i] + MATRIX_X_OFFSET;
+		matrix_y[i] = y[i] + MATRIX_Y_OFFSET;
 	}
+	animation_blink(matrix_x, matrix_y, count, object_colour(object),
+			palette[EMPTY_SQUARE], BLINK_TIMES, BLINK_STEP_MS);
+}
 
-	// update the pixel at the given location with this colour
-	// the board is offset on the x axis to be centered on the LED matrix
-	ledmatrix_update_pixel(x + MATRIX_X_OFFSET, y + MATRIX_Y_OFFSET, colour);
-}
\ No newline at end of file
+void show_winner_banner(uint8_t player) {
+	if (player == PLAYER_1) {
+		scroll_banner(PSTR("P1 WINS   "), palette[PLAYER_1]);
+	} else {
+		scroll_banner(PSTR("P2 WINS   "), palette[PLAYER_2]);
+	}
+}
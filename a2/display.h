@@ -25,18 +25,46 @@
 #define PLAYER_2		2
 #define CURSOR			3
 
-// matrix colour definitions
+// matrix colour definitions (for the standard theme)
 #define MATRIX_COLOUR_EMPTY		COLOUR_BLACK
 #define MATRIX_COLOUR_P1		COLOUR_GREEN
 #define MATRIX_COLOUR_P2		COLOUR_RED
 #define MATRIX_COLOUR_CURSOR	COLOUR_ORANGE
 #define MATRIX_COLOUR_BG		COLOUR_LIGHT_YELLOW 
+#define MATRIX_COLOUR_P1_TRAIL	0x30	// dim green
+#define MATRIX_COLOUR_P2_TRAIL	0x03	// dim red
+
+// Colours are looked up in a palette, indexed by the object definitions
+// above and then these entries
+#define PALETTE_BG			4
+#define PALETTE_P1_TRAIL	5
+#define PALETTE_P2_TRAIL	6
+#define PALETTE_SIZE		7
+
+// palettes which set_display_theme() can load
+#define THEME_STANDARD		0
+#define THEME_COLOUR_BLIND	1	// players told apart by brightness
+#define NUM_THEMES			2
+
+// animation timings (in milliseconds)
+#define BANNER_STEP_MS	100
+#define SLIDE_STEP_MS	150
+#define BLINK_STEP_MS	200
+#define BLINK_TIMES		5
 
 // initialise the display for the board, this creates the display
 // for an empty board
 void initialise_display(void);
 
-// shows a starting display
+// Loads the palette for 'theme' (one of the THEME_ values above) or
+// changes one palette entry. Squares already drawn keep their colour until
+// they are redrawn.
+void set_display_theme(uint8_t theme);
+uint8_t get_display_theme(void);
+void set_palette_colour(uint8_t entry, PixelColour colour);
+
+// shows a starting display, which scrolls until initialise_display() is
+// called
 void start_display(void);
 
 // updates the colour at square (x, y) to be the colour
@@ -44,5 +72,29 @@ void start_display(void);
 // 'object' is expected to be EMPTY_SQUARE, PLAYER_1, PLAYER_2 or CURSOR
 void update_square_colour(uint8_t x, uint8_t y, uint8_t object);
 
+// updates the squares (x[i], y[i]) to the colours of objects[i], for i
+// from 0 to count-1, all in the same display frame. (The LED matrix sends
+// whichever row or pixel updates are cheapest for the squares which
+// changed.)
+void update_square_colours(const uint8_t* x, const uint8_t* y,
+		const uint8_t* objects, uint8_t count);
+
+// updates every square (x, y) to the colour of objects[y][x], all in the
+// same display frame
+void update_board_colours(const uint8_t objects[HEIGHT][WIDTH]);
+
+// shows the piece 'object' (PLAYER_1 or PLAYER_2) sliding from square
+// (from_x, from_y) to the empty square (to_x, to_y)
+void slide_square_colour(uint8_t from_x, uint8_t from_y, uint8_t to_x,
+		uint8_t to_y, uint8_t object);
+
+// blinks the 'count' squares (x[i], y[i]) which hold the piece 'object'
+void blink_squares(const uint8_t* x, const uint8_t* y, uint8_t count,
+		uint8_t object);
+
+// scrolls a banner naming 'player' (PLAYER_1 or PLAYER_2) as the winner
+// until initialise_display() is called
+void show_winner_banner(uint8_t player);
+
 
 #endif /* DISPLAY_H_ */
\ No newline at end of file
@@ -0,0 +1,143 @@
+/*
+ * font.c
+ *
+ * Glyphs are stored a byte per column, left to right, with bit 0 the top
+ * row and bit 6 the bottom one.
+ */
+
+#include "font.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define FIRST_GLYPH ' '
+#define LAST_GLYPH 'Z'
+
+// the first character which isn't a colour code
+#define FIRST_PRINTABLE ' '
+
+static const uint8_t glyphs[LAST_GLYPH - FIRST_GLYPH + 1][FONT_GLYPH_WIDTH]
+		PROGMEM = {
+	{0x00, 0x00, 0x00, 0x00, 0x00},	// space
+	{0x00, 0x00, 0x5F, 0x00, 0x00},	// !
+	{0x00, 0x07, 0x00, 0x07, 0x00},	// "
+	{0x14, 0x7F, 0x14, 0x7F, 0x14},	// #
+	{0x24, 0x2A, 0x7F, 0x2A, 0x12},	// $
+	{0x23, 0x13, 0x08, 0x64, 0x62},	// %
+	{0x36, 0x49, 0x56, 0x20, 0x50},	// &
+	{0x00, 0x05, 0x03, 0x00, 0x00},	// '
+	{0x00, 0x1C, 0x22, 0x41, 0x00},	// (
+	{0x00, 0x41, 0x22, 0x1C, 0x00},	// )
+	{0x2A, 0x1C, 0x7F, 0x1C, 0x2A},	// *
+	{0x08, 0x08, 0x3E, 0x08, 0x08},	// +
+	{0x00, 0x50, 0x30, 0x00, 0x00},	// ,
+	{0x08, 0x08, 0x08, 0x08, 0x08},	// -
+	{0x00, 0x60, 0x60, 0x00, 0x00},	// .
+	{0x20, 0x10, 0x08, 0x04, 0x02},	// /
+	{0x3E, 0x51, 0x49, 0x45, 0x3E},	// 0
+	{0x00, 0x42, 0x7F, 0x40, 0x00},	// 1
+	{0x42, 0x61, 0x51, 0x49, 0x46},	// 2
+	{0x21, 0x41, 0x45, 0x4B, 0x31},	// 3
+	{0x18, 0x14, 0x12, 0x7F, 0x10},	// 4
+	{0x27, 0x45, 0x45, 0x45, 0x39},	// 5
+	{0x3C, 0x4A, 0x49, 0x49, 0x30},	// 6
+	{0x01, 0x71, 0x09, 0x05, 0x03},	// 7
+	{0x36, 0x49, 0x49, 0x49, 0x36},	// 8
+	{0x06, 0x49, 0x49, 0x29, 0x1E},	// 9
+	{0x00, 0x36, 0x36, 0x00, 0x00},	// :
+	{0x00, 0x56, 0x36, 0x00, 0x00},	// ;
+	{0x08, 0x14, 0x22, 0x41, 0x00},	// <
+	{0x14, 0x14, 0x14, 0x14, 0x14},	// =
+	{0x00, 0x41, 0x22, 0x14, 0x08},	// >
+	{0x02, 0x01, 0x51, 0x09, 0x06},	// ?
+	{0x32, 0x49, 0x79, 0x41, 0x3E},	// @
+	{0x7E, 0x11, 0x11, 0x11, 0x7E},	// A
+	{0x7F, 0x49, 0x49, 0x49, 0x36},	// B
+	{0x3E, 0x41, 0x41, 0x41, 0x22},	// C
+	{0x7F, 0x41, 0x41, 0x22, 0x1C},	// D
+	{0x7F, 0x49, 0x49, 0x49, 0x41},	// E
+	{0x7F, 0x09, 0x09, 0x09, 0x01},	// F
+	{0x3E, 0x41, 0x49, 0x49, 0x7A},	// G
+	{0x7F, 0x08, 0x08, 0x08, 0x7F},	// H
+	{0x00, 0x41, 0x7F, 0x41, 0x00},	// I
+	{0x20, 0x40, 0x41, 0x3F, 0x01},	// J
+	{0x7F, 0x08, 0x14, 0x22, 0x41},	// K
+	{0x7F, 0x40, 0x40, 0x40, 0x40},	// L
+	{0x7F, 0x02, 0x0C, 0x02, 0x7F},	// M
+	{0x7F, 0x04, 0x08, 0x10, 0x7F},	// N
+	{0x3E, 0x41, 0x41, 0x41, 0x3E},	// O
+	{0x7F, 0x09, 0x09, 0x09, 0x06},	// P
+	{0x3E, 0x41, 0x51, 0x21, 0x5E},	// Q
+	{0x7F, 0x09, 0x19, 0x29, 0x46},	// R
+	{0x46, 0x49, 0x49, 0x49, 0x31},	// S
+	{0x01, 0x01, 0x7F, 0x01, 0x01},	// T
+	{0x3F, 0x40, 0x40, 0x40, 0x3F},	// U
+	{0x1F, 0x20, 0x40, 0x20, 0x1F},	// V
+	{0x3F, 0x40, 0x38, 0x40, 0x3F},	// W
+	{0x63, 0x14, 0x08, 0x14, 0x63},	// X
+	{0x07, 0x08, 0x70, 0x08, 0x07},	// Y
+	{0x61, 0x51, 0x49, 0x45, 0x43}	// Z
+};
+
+// colours selected by the TEXT_ codes, starting from code 1
+static const PixelColour text_colours[] PROGMEM = {
+	COLOUR_RED, COLOUR_GREEN, COLOUR_YELLOW, COLOUR_ORANGE,
+	COLOUR_LIGHT_YELLOW
+};
+
+void font_char_column(char c, uint8_t index, PixelColour colour,
+		MatrixColumn column) {
+	if (c >= 'a' && c <= 'z') {
+		c -= 'a' - 'A';
+	} else if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+		c = '?';
+	}
+	uint8_t bits = 0;
+	if (index < FONT_GLYPH_WIDTH) {
+		bits = pgm_read_byte(&glyphs[c - FIRST_GLYPH][index]);
+	}
+	// bit 0 is the top row
+	for (uint8_t y = MATRIX_NUM_ROWS; y > 0; y--) {
+		column[y - 1] = (bits & 1) ? colour : COLOUR_BLACK;
+		bits >>= 1;
+	}
+}
+
+uint16_t font_text_width(const char* text) {
+	uint16_t width = 0;
+	char c;
+	while ((c = pgm_read_byte(text++))) {
+		if ((uint8_t)c >= FIRST_PRINTABLE) {
+			width += FONT_CHAR_WIDTH;
+		}
+	}
+	return width;
+}
+
+uint8_t font_text_column(const char* text, PixelColour colour, uint16_t index,
+		MatrixColumn column) {
+	char c;
+	while ((c = pgm_read_byte(text++))) {
+		if ((uint8_t)c < FIRST_PRINTABLE) {
+			if ((uint8_t)c <= sizeof(text_colours)) {
+				colour = pgm_read_byte(&text_colours[c - 1]);
+			}
+		} else if (index < FONT_CHAR_WIDTH) {
+			font_char_column(c, index, colour, column);
+			return 1;
+		} else {
+			index -= FONT_CHAR_WIDTH;
+		}
+	}
+	return 0;
+}
+
+void font_draw_text(int8_t x, const char* text, PixelColour colour) {
+	MatrixColumn column;
+	for (uint8_t matrix_x = (x < 0) ? 0 : x; matrix_x < MATRIX_NUM_COLUMNS;
+			matrix_x++) {
+		if (!font_text_column(text, colour, matrix_x - x, column)) {
+			break;
+		}
+		ledmatrix_update_column(matrix_x, column);
+	}
+}
@@ -0,0 +1,53 @@
+/*
+ * font.h
+ *
+ * A 5x7 font in flash, and text drawing for the LED matrix. Text is drawn
+ * one matrix column at a time straight from flash (strings included), so
+ * a message takes no SRAM and can be streamed into a scrolling banner.
+ *
+ * Characters are 5 columns wide with one blank column after each, and sit
+ * in the top 7 rows of the matrix. Lower case letters are drawn as upper
+ * case and characters without a glyph as '?'.
+ *
+ * Text can change colour part way through by including one of the TEXT_
+ * codes below, e.g. PSTR(TEXT_RED "P2" TEXT_YELLOW " WINS").
+ */
+
+
+#ifndef FONT_H_
+#define FONT_H_
+
+#include <stdint.h>
+#include "ledmatrix.h"
+
+#define FONT_GLYPH_WIDTH	5
+#define FONT_CHAR_WIDTH		(FONT_GLYPH_WIDTH + 1)
+
+// colour codes which can appear in text
+#define TEXT_RED			"\x01"
+#define TEXT_GREEN			"\x02"
+#define TEXT_YELLOW			"\x03"
+#define TEXT_ORANGE			"\x04"
+#define TEXT_LIGHT_YELLOW	"\x05"
+
+// Fills 'column' with column 'index' (0 to FONT_CHAR_WIDTH-1, the last
+// being the blank gap) of the character 'c' drawn in 'colour'.
+void font_char_column(char c, uint8_t index, PixelColour colour,
+		MatrixColumn column);
+
+// returns the width in columns of the text 'text' (a string in flash)
+uint16_t font_text_width(const char* text);
+
+// Fills 'column' with column 'index' of the text 'text' (a string in
+// flash), which is drawn in 'colour' until a colour code says otherwise.
+// Returns 1, or 0 (leaving 'column' alone) if the text is narrower.
+uint8_t font_text_column(const char* text, PixelColour colour, uint16_t index,
+		MatrixColumn column);
+
+// Draws the text 'text' (a string in flash) on the matrix in 'colour',
+// with its first column at x (which may be off the left edge). Columns
+// off the matrix, and those to the right of the text, are left alone.
+void font_draw_text(int8_t x, const char* text, PixelColour colour);
+
+
+#endif /* FONT_H_ */
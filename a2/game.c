@@ -10,14 +10,28 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "display.h"
+#include "ledmatrix.h"
+#include "protocol.h"
 #include "terminalio.h"
+#include "termscreen.h"
+
+// where the board's mirror and the status panel beside it go in the
+// terminal screen grid
+#define PANEL_COL (2 * WIDTH + 2)
+#define PANEL_WIDTH (TERM_SCREEN_COLS - PANEL_COL)
 
 // Start pieces in the middle of the board
 #define CURSOR_X_START ((int)(WIDTH/2))
 #define CURSOR_Y_START ((int)(HEIGHT/2))
 
-uint8_t board[WIDTH][HEIGHT];
+// the board is kept as one bitboard per player (index 0 is PLAYER_1 and
+// index 1 is PLAYER_2) plus a mask of every occupied square. The occupied
+// mask is always the OR of the two player bitboards.
+Bitboard player_pieces[2];
+Bitboard occupied;
+
 // cursor coordinates should be /* SIGNED */ to allow left and down movement.
 // All other positions should be unsigned as there are no negative coordinates.
 int8_t cursor_x;
@@ -25,17 +39,31 @@ int8_t cursor_y;
 uint8_t cursor_visible;
 uint8_t current_player;
 
+// number of pieces dropped so far. Once both players have placed all of
+// their pieces the game moves into the movement phase.
+uint8_t pieces_placed;
+// in the movement phase, the square of the piece picked up to be moved
+// (or NO_SQUARE if no piece has been picked up yet)
+uint8_t selected_square;
+// result of win detection, updated whenever a square changes so that
+// is_game_over() only needs to read it
+uint8_t game_over;
+// Zobrist hash of the current position, updated as each move is played
+uint32_t position_hash;
+
 void initialise_game(void) {
 	
 	// initialise the display we are using
 	initialise_display();
 	
 	// initialise the board to be all empty
-	for (uint8_t x = 0; x < WIDTH; x++) {
-		for (uint8_t y = 0; y < HEIGHT; y++) {
-			board[x][y] = EMPTY_SQUARE;
-		}
-	}
+	player_pieces[0] = 0;
+	player_pieces[1] = 0;
+	occupied = 0;
+	pieces_placed = 0;
+	selected_square = NO_SQUARE;
+	game_over = 0;
+	position_hash = 0;
 	
 	// set the starting player
 	current_player = PLAYER_1;
@@ -49,14 +77,40 @@ void initialise_game(void) {
 uint8_t get_piece_at(uint8_t x, uint8_t y) {
 	// check the bounds, anything outside the bounds
 	// will be considered empty
-	if (x < 0 || x >= WIDTH || y < 0 || y >= WIDTH) {
+	if (x >= WIDTH || y >= HEIGHT) {
 		return EMPTY_SQUARE;
+	}
+	// if in the bounds, test the square's bit in each bitboard
+	Bitboard bit = SQUARE_BIT(x, y);
+	if (!(occupied & bit)) {
+		return EMPTY_SQUARE;
+	} else if (player_pieces[0] & bit) {
+		return PLAYER_1;
 	} else {
-		//if in the bounds, just index into the array
-		return board[x][y];
+		return PLAYER_2;
 	}
 }
 
+Bitboard get_player_pieces(uint8_t player) {
+	return player_pieces[player - PLAYER_1];
+}
+
+Bitboard get_occupied_squares(void) {
+	return occupied;
+}
+
+uint8_t get_current_player(void) {
+	return current_player;
+}
+
+uint8_t get_pieces_placed(void) {
+	return pieces_placed;
+}
+
+uint32_t get_position_hash(void) {
+	return position_hash;
+}
+
 void flash_cursor(void) {
 	
 	if (cursor_visible) {
@@ -72,6 +126,70 @@ void flash_cursor(void) {
 	cursor_visible = 1 - cursor_visible; //alternate between 0 and 1
 }
 
+void redraw_board(void) {
+	uint8_t objects[HEIGHT][WIDTH];
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		for (uint8_t x = 0; x < WIDTH; x++) {
+			objects[y][x] = get_piece_at(x, y);
+		}
+	}
+	if (cursor_visible) {
+		objects[cursor_y][cursor_x] = CURSOR;
+	}
+	// repaint the background too, in case the colours have changed. Only
+	// the squares which end up a different colour are sent.
+	ledmatrix_begin_update();
+	initialise_display();
+	update_board_colours(objects);
+	ledmatrix_end_update();
+}
+
+static uint8_t player_colour(uint8_t player) {
+	return (player == PLAYER_1) ? FG_GREEN : FG_RED;
+}
+
+void draw_terminal_board(const char* message) {
+	// the board, top row first, one square every other column
+	for (uint8_t y = 0; y < HEIGHT; y++) {
+		for (uint8_t x = 0; x < WIDTH; x++) {
+			uint8_t piece = get_piece_at(x, y);
+			uint8_t cell = '.';
+			if (cursor_visible && x == cursor_x && y == cursor_y) {
+				cell = TERM_GLYPH(FG_YELLOW, TERM_GLYPH_CURSOR);
+			} else if (SQUARE_INDEX(x, y) == selected_square) {
+				cell = TERM_GLYPH(player_colour(piece), TERM_GLYPH_SELECTED);
+			} else if (piece != EMPTY_SQUARE) {
+				cell = TERM_GLYPH(player_colour(piece), TERM_GLYPH_PIECE);
+			}
+			term_screen_put(HEIGHT - 1 - y, 2 * x, cell);
+		}
+	}
+
+	// the status panel: whose turn it is (or who won), and what they are
+	// to do
+	uint8_t player = current_player;
+	if (game_over) {
+		player = (player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	}
+	term_screen_put(0, PANEL_COL, TERM_GLYPH(player_colour(player),
+			TERM_GLYPH_PIECE));
+	term_screen_print_P(0, PANEL_COL + 2, PANEL_WIDTH - 2,
+			(player == PLAYER_1) ? PSTR("Player 1") : PSTR("Player 2"));
+	if (game_over) {
+		term_screen_print_P(1, PANEL_COL, PANEL_WIDTH, PSTR("Wins!"));
+	} else if (pieces_placed < 2 * PIECES_PER_PLAYER) {
+		// each cell is written once, so an unchanged line costs nothing
+		term_screen_print_P(1, PANEL_COL, 11, PSTR("Drop piece "));
+		term_screen_put(1, PANEL_COL + 11, '1' + pieces_placed / 2);
+		term_screen_print_P(1, PANEL_COL + 12, PANEL_WIDTH - 12, PSTR("/4"));
+	} else if (selected_square == NO_SQUARE) {
+		term_screen_print_P(1, PANEL_COL, PANEL_WIDTH, PSTR("Pick a piece up"));
+	} else {
+		term_screen_print_P(1, PANEL_COL, PANEL_WIDTH, PSTR("Move it"));
+	}
+	term_screen_print_P(3, PANEL_COL, PANEL_WIDTH, message ? message : PSTR(""));
+}
+
 //check the header file game.h for a description of what this function should do
 // (it may contain some hints as to how to move the cursor)
 void move_display_cursor(int8_t dx, int8_t dy) {
@@ -108,8 +226,135 @@ void move_display_cursor(int8_t dx, int8_t dy) {
 	flash_cursor();
 }
 
+// blinks the pattern which 'pieces' (the winner's pieces) make
+static void show_winning_pattern(Bitboard pieces) {
+	for (uint8_t i = 0; i < NUM_WIN_MASKS; i++) {
+		Bitboard mask = get_win_mask(i);
+		if ((pieces & mask) != mask) {
+			continue;
+		}
+		uint8_t x[PIECES_PER_PLAYER], y[PIECES_PER_PLAYER];
+		uint8_t count = 0;
+		for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+			if (mask & ((Bitboard)1 << square)) {
+				x[count] = square % WIDTH;
+				y[count] = square / WIDTH;
+				count++;
+			}
+		}
+		blink_squares(x, y, count, current_player);
+		return;
+	}
+}
+
+void play_move(uint8_t from, uint8_t to) {
+	Bitboard* own_pieces = &player_pieces[current_player - PLAYER_1];
+	Bitboard change = (Bitboard)1 << to;
+
+	if (from == NO_SQUARE) {
+		pieces_placed++;
+		update_square_colour(to % WIDTH, to / WIDTH, current_player);
+	} else {
+		change |= (Bitboard)1 << from;
+		slide_square_colour(from % WIDTH, from / WIDTH, to % WIDTH, to / WIDTH,
+				current_player);
+	}
+	*own_pieces ^= change;
+	occupied ^= change;
+	position_hash ^= move_hash_change(current_player, from, to);
+	selected_square = NO_SQUARE;
+
+	// if the cursor was on a square which just changed it has been drawn
+	// over, so restart its flash cycle
+	uint8_t cursor_square = SQUARE_INDEX(cursor_x, cursor_y);
+	if (cursor_square == to || cursor_square == from) {
+		cursor_visible = 0;
+	}
+
+	// only the square which just gained a piece can complete a pattern, and
+	// only for the player who moved there
+	game_over = pieces_win_through(*own_pieces, to);
+	if (game_over) {
+		show_winning_pattern(*own_pieces);
+	}
+
+	current_player = (current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	protocol_board_changed();
+}
+
+void piece_placement(void) {
+	if (game_over) {
+		return;
+	}
+	uint8_t square = SQUARE_INDEX(cursor_x, cursor_y);
+	Bitboard bit = SQUARE_BIT(cursor_x, cursor_y);
+	Bitboard own_pieces = player_pieces[current_player - PLAYER_1];
+
+	// in the movement phase the player first picks up one of their own
+	// pieces (picking up another one changes their mind), then chooses an
+	// adjacent empty square to move it to
+	if (pieces_placed >= 2 * PIECES_PER_PLAYER && (own_pieces & bit)) {
+		selected_square = square;
+		return;
+	}
+	uint8_t from = (pieces_placed < 2 * PIECES_PER_PLAYER) ?
+			NO_SQUARE : selected_square;
+	if (is_legal_move(own_pieces, occupied, pieces_placed, from, square)) {
+		play_move(from, square);
+	}
+}
+
+void pass_turn(void) {
+	selected_square = NO_SQUARE;
+	position_hash ^= ZOBRIST_SIDE_KEY;
+	current_player = (current_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	protocol_board_changed();
+}
+
+uint8_t load_position(Bitboard p1_pieces, Bitboard p2_pieces,
+		uint8_t player) {
+	uint8_t p1_count = count_pieces(p1_pieces);
+	uint8_t p2_count = count_pieces(p2_pieces);
+	uint8_t placed = p1_count + p2_count;
+	// in the drop phase player 1 has dropped one more piece than player
+	// 2 when it is player 2's turn, and the same number otherwise
+	uint8_t drop_player = (p1_count > p2_count) ? PLAYER_2 : PLAYER_1;
+	if ((p1_pieces & p2_pieces) || ((p1_pieces | p2_pieces) & ~BOARD_MASK) ||
+			(player != PLAYER_1 && player != PLAYER_2) ||
+			p1_count > PIECES_PER_PLAYER || p2_count > PIECES_PER_PLAYER ||
+			p1_count - p2_count > 1 || p2_count > p1_count ||
+			(placed < 2 * PIECES_PER_PLAYER && player != drop_player) ||
+			pieces_have_won(p1_pieces) || pieces_have_won(p2_pieces)) {
+		return 0;
+	}
+
+	player_pieces[0] = p1_pieces;
+	player_pieces[1] = p2_pieces;
+	occupied = p1_pieces | p2_pieces;
+	pieces_placed = placed;
+	selected_square = NO_SQUARE;
+	game_over = 0;
+	current_player = player;
+
+	// the hash of a position is the XOR of the keys of its pieces (each
+	// one dropped there) and the side key if player 2 is to move
+	position_hash = (player == PLAYER_2) ? ZOBRIST_SIDE_KEY : 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		Bitboard bit = (Bitboard)1 << square;
+		if (occupied & bit) {
+			position_hash ^= ZOBRIST_SIDE_KEY ^ move_hash_change(
+					(p1_pieces & bit) ? PLAYER_1 : PLAYER_2, NO_SQUARE, square);
+		}
+	}
+
+	cursor_visible = 0;
+	redraw_board();
+	protocol_board_changed();
+	return 1;
+}
+
 uint8_t is_game_over(void) {
-	// YOUR CODE HERE
-	// Detect if the game is over i.e. if a player has won.
-	return 0;
-}
\ No newline at end of file
+	// win detection is done as each piece is placed or moved, so this is
+	// just a read of the cached result
+	return game_over;
+}
@@ -11,6 +11,8 @@
 #define GAME_H_
 
 #include <stdint.h>
+#include "display.h"
+#include "teeko.h"
 
 // initialise the display of the board, this creates the internal board
 // and also updates the display of the board
@@ -21,10 +23,35 @@ void initialise_game(void);
 // anything outside the bounds of the boards will be SQUARE_EMPTY
 uint8_t get_piece_at(uint8_t x, uint8_t y);
 
+// returns the bitboard of pieces belonging to player (PLAYER_1 or PLAYER_2)
+Bitboard get_player_pieces(uint8_t player);
+
+// returns the bitboard of all occupied squares
+Bitboard get_occupied_squares(void);
+
+// returns the player whose turn it is (PLAYER_1 or PLAYER_2)
+uint8_t get_current_player(void);
+
+// returns how many pieces have been dropped so far. The game is in the
+// movement phase once this reaches 2 * PIECES_PER_PLAYER.
+uint8_t get_pieces_placed(void);
+
+// returns the Zobrist hash of the current position
+uint32_t get_position_hash(void);
+
 // update the cursor display, by changing whether it is visible or not
 // call this function at regular intervals to have the cursor flash
 void flash_cursor(void);
 
+// redraws the whole board (e.g. after the display theme is changed)
+void redraw_board(void);
+
+// draws the board and a status panel (whose turn it is and what they are
+// to do) into the terminal screen grid, with the program memory string
+// 'message' (or nothing if it is NULL) underneath. Only what has changed
+// is sent when the grid is next flushed.
+void draw_terminal_board(const char* message);
+
 // moves the position of the cursor by (dx, dy) such that if the cursor
 // started at (cursor_x, cursor_y) then after this function is called, 
 // it should end at ( (cursor_x + dx) % WIDTH, (cursor_y + dy) % HEIGHT)
@@ -33,8 +60,28 @@ void move_display_cursor(int8_t dx, int8_t dy);
 
 // attempt to place a piece at the current position. If successful, the
 // active player is switched.
+// Once all pieces have been dropped, the first call on one of the active
+// player's pieces picks it up and a later call on an adjacent empty square
+// moves it there.
 void piece_placement(void);
 
+// plays a move for the active player and switches the active player. 'from'
+// and 'to' are square indices; for a drop 'from' is NO_SQUARE. The move is
+// assumed to be legal.
+void play_move(uint8_t from, uint8_t to);
+
+// switches the active player without a move, for a player who has no
+// legal move
+void pass_turn(void);
+
+// sets up the position with the pieces 'p1_pieces' and 'p2_pieces' and
+// 'player' (PLAYER_1 or PLAYER_2) to move. Returns 1 if the position was
+// loaded, or 0 (leaving the game as it was) if it could not come up in a
+// game: too many pieces, the wrong player to move in the drop phase, or a
+// player has already won.
+uint8_t load_position(Bitboard p1_pieces, Bitboard p2_pieces,
+		uint8_t player);
+
 // returns 1 if the game is over, 0 otherwise
 uint8_t is_game_over(void);
 
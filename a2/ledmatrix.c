@@ -4,10 +4,27 @@
  * Author: Peter Sutton
  * 
  * See the LED matrix Reference for details of the SPI commands used.
+ *
+ * A copy of what the matrix shows is kept in a shadow framebuffer, with a
+ * dirty bit for each pixel whose colour has changed since it was last
+ * sent. Updates only change the framebuffer. Once per frame (driven from
+ * the timer0 interrupt by ledmatrix_frame_tick()) the dirty pixels are
+ * sent using a mix of pixel, row, column and whole display commands
+ * chosen to take few SPI bytes, so a pixel changed several times
+ * in a frame is sent once, and writing a pixel with the colour it already
+ * has costs nothing. Clears and shifts are also held until the frame is
+ * sent, with the framebuffer (and its dirty bits) changed to match at
+ * once.
+ *
+ * Commands are queued for the SPI interrupt to send (see spi.h). A frame
+ * is only started once the previous one has been sent; a frame which is
+ * due before then is counted as an overrun and sent as soon as possible.
  */ 
 
 #include "ledmatrix.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include "spi.h"
 
 #define CMD_UPDATE_ALL 0x00
@@ -17,18 +34,325 @@
 #define CMD_SHIFT_DISPLAY 0x04
 #define CMD_CLEAR_SCREEN 0x0F
 
+// CMD_SHIFT_DISPLAY directions
+#define SHIFT_RIGHT 0x01
+#define SHIFT_LEFT 0x02
+#define SHIFT_DOWN 0x04
+#define SHIFT_UP 0x08
+
+// SPI bytes taken by each update command
+#define PIXEL_COST 3
+#define ROW_COST (2 + MATRIX_NUM_COLUMNS)
+#define COLUMN_COST (2 + MATRIX_NUM_ROWS)
+#define ALL_COST (1 + MATRIX_NUM_COLUMNS * MATRIX_NUM_ROWS)
+
+// A row update can replace at most ROW_COST / PIXEL_COST pixel updates,
+// so only rows with more dirty pixels than that are worth sending whole.
+#define MIN_ROW_DIRTY (ROW_COST / PIXEL_COST + 1)
+
+// No command sends a pixel for less than ROW_COST / MATRIX_NUM_COLUMNS
+// bytes, so with this many dirty pixels nothing beats resending it all.
+#define MIN_ALL_DIRTY ((ALL_COST * MATRIX_NUM_COLUMNS + ROW_COST - 1) / ROW_COST)
+
+// Shift commands held for the next frame. If more are made in one frame
+// the whole display is resent instead.
+#define MAX_PENDING_SHIFTS 4
+
+// the colours the matrix shows once dirty pixels have been sent
+static MatrixData frame;
+
+// dirty_columns[x] has bit y set if pixel (x,y) has not been sent
+static uint8_t dirty_columns[MATRIX_NUM_COLUMNS];
+
+// commands to send before the dirty pixels in the next frame
+static uint8_t clear_pending;
+static uint8_t pending_shifts[MAX_PENDING_SHIFTS];
+static uint8_t num_pending_shifts;
+
+// frame timing, in timer0 ticks (milliseconds). Below 4 frames a second
+// the period is more than 255 ms.
+static uint16_t frame_period = (1000 + LEDMATRIX_DEFAULT_FRAME_RATE / 2) /
+		LEDMATRIX_DEFAULT_FRAME_RATE;
+static uint16_t ms_until_frame = 1;
+static uint8_t frame_late;
+static volatile uint8_t sending_frame;
+static volatile uint8_t update_depth;
+static LedMatrixStats stats;
+
+// number of bits set in each 4 bit value
+static const uint8_t nibble_bits[16] PROGMEM = {
+	0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+static uint8_t count_bits(uint8_t bits) {
+	return pgm_read_byte(&nibble_bits[bits & 0x0F]) +
+			pgm_read_byte(&nibble_bits[bits >> 4]);
+}
+
+// cost of sending the pixels in 'rows' of one column, using pixel updates
+// or one column update
+static uint8_t column_cost(uint8_t rows) {
+	uint8_t cost = PIXEL_COST * count_bits(rows);
+	return (cost > COLUMN_COST) ? COLUMN_COST : cost;
+}
+
+// Returns the cost of sending every dirty pixel when the rows in 'rows' are
+// sent whole. Pixels in the other rows are sent by column or pixel,
+// whichever is cheaper for each column.
+static uint16_t flush_cost(uint8_t rows) {
+	uint16_t cost = ROW_COST * count_bits(rows);
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		cost += column_cost(dirty_columns[x] & ~rows);
+	}
+	return cost;
+}
+
+// Sets a pixel of the framebuffer. Interrupts are disabled while doing so
+// since a frame may be sent at any time.
+static void set_pixel(uint8_t x, uint8_t y, PixelColour pixel) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	if (frame[x][y] != pixel) {
+		frame[x][y] = pixel;
+		dirty_columns[x] |= (1 << y);
+	}
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+static void send_row(uint8_t y) {
+	spi_queue_byte(CMD_UPDATE_ROW);
+	spi_queue_byte(y & 0x07);	// row number
+	for(uint8_t x = 0; x<MATRIX_NUM_COLUMNS; x++) {
+		spi_queue_byte(frame[x][y]);
+	}
+}
+
+static void send_column(uint8_t x) {
+	spi_queue_byte(CMD_UPDATE_COL);
+	spi_queue_byte(x & 0x0F); // column number
+	for(uint8_t y = 0; y<MATRIX_NUM_ROWS; y++) {
+		spi_queue_byte(frame[x][y]);
+	}
+}
+
+static void send_pixel(uint8_t x, uint8_t y) {
+	spi_queue_byte(CMD_UPDATE_PIXEL);
+	spi_queue_byte( ((y & 0x07)<<4) | (x & 0x0F));
+	spi_queue_byte(frame[x][y]);
+}
+
+static void send_all(void) {
+	spi_queue_byte(CMD_UPDATE_ALL);
+	for(uint8_t y=0; y<MATRIX_NUM_ROWS; y++) {
+		for(uint8_t x=0; x<MATRIX_NUM_COLUMNS; x++) {
+			spi_queue_byte(frame[x][y]);
+		}
+	}
+}
+
 void ledmatrix_setup(void) {
 	// Setup SPI - we divide the clock by 128.
 	// (This speed guarantees the SPI buffer will never overflow on
 	// the LED matrix.)
 	spi_setup_master(128);
+	
+	// Start from a blank display so that it matches the framebuffer
+	ledmatrix_clear();
+}
+
+// Sends everything held for this frame and returns the number of bytes
+// queued to do so.
+static uint8_t send_frame(void) {
+	uint8_t bytes = 0;
+	if (clear_pending) {
+		spi_queue_byte(CMD_CLEAR_SCREEN);
+		clear_pending = 0;
+		bytes++;
+	}
+	for (uint8_t i = 0; i < num_pending_shifts; i++) {
+		spi_queue_byte(CMD_SHIFT_DISPLAY);
+		spi_queue_byte(pending_shifts[i]);
+		bytes += 2;
+	}
+	num_pending_shifts = 0;
+	
+	uint8_t any_dirty = 0;
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		any_dirty |= dirty_columns[x];
+	}
+	if (!any_dirty) {
+		return bytes;
+	}
+	
+	// Only rows dirty enough to be worth it are candidates to send whole.
+	uint8_t candidate_rows = 0;
+	uint8_t total_dirty = 0;
+	for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+		uint8_t dirty = 0;
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			dirty += (dirty_columns[x] >> y) & 1;
+		}
+		if (dirty >= MIN_ROW_DIRTY) {
+			candidate_rows |= (1 << y);
+		}
+		total_dirty += dirty;
+	}
+	uint8_t best_rows = 0;
+	uint16_t best_cost = ALL_COST;
+	if (total_dirty < MIN_ALL_DIRTY) {
+		// This runs in the timer interrupt, so rather than trying every
+		// combination of candidates (up to 255 of them) the one which
+		// saves most is added while any still saves something. That is
+		// at most 36 tries, and usually one or two.
+		best_cost = flush_cost(0);
+		while (candidate_rows) {
+			uint8_t best_row = 0;
+			for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+				if (!(candidate_rows & (1 << y))) {
+					continue;
+				}
+				uint16_t cost = flush_cost(best_rows | (1 << y));
+				if (cost < best_cost) {
+					best_cost = cost;
+					best_row = 1 << y;
+				}
+			}
+			if (!best_row) {
+				break;
+			}
+			best_rows |= best_row;
+			candidate_rows &= ~best_row;
+		}
+	}
+
+	if (best_cost >= ALL_COST) {
+		send_all();
+	} else {
+		for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+			if (best_rows & (1 << y)) {
+				send_row(y);
+			}
+		}
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			uint8_t rows = dirty_columns[x] & ~best_rows;
+			if (!rows) {
+				continue;
+			}
+			if (column_cost(rows) == COLUMN_COST) {
+				send_column(x);
+			} else {
+				for (uint8_t y = 0; y < MATRIX_NUM_ROWS; y++) {
+					if (rows & (1 << y)) {
+						send_pixel(x, y);
+					}
+				}
+			}
+		}
+	}
+	for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+		dirty_columns[x] = 0;
+	}
+	return bytes + ((best_cost < ALL_COST) ? best_cost : ALL_COST);
+}
+
+void ledmatrix_frame_tick(void) {
+	if (sending_frame || --ms_until_frame) {
+		return;
+	}
+	// The frame is due. If changes are part way through being made, or the
+	// last frame is still being sent, try again next tick.
+	if (update_depth) {
+		ms_until_frame = 1;
+		return;
+	}
+	if (spi_queue_depth()) {
+		if (!frame_late) {
+			stats.overruns++;
+			frame_late = 1;
+		}
+		ms_until_frame = 1;
+		return;
+	}
+	frame_late = 0;
+	ms_until_frame = frame_period;
+	
+	// Working out what to send can take a while, so the frame is sent with
+	// interrupts enabled. Ticks while it is sent are ignored. The rest of
+	// this module changes the framebuffer with interrupts disabled, so it
+	// never sees a frame half sent.
+	sending_frame = 1;
+	sei();
+	uint8_t bytes = send_frame();
+	cli();
+	sending_frame = 0;
+	
+	stats.frames++;
+	stats.last_frame_bytes = bytes;
+	if (bytes > stats.max_frame_bytes) {
+		stats.max_frame_bytes = bytes;
+	}
+	stats.total_bytes += bytes;
+}
+
+void ledmatrix_begin_update(void) {
+	update_depth++;
+}
+
+void ledmatrix_end_update(void) {
+	update_depth--;
+}
+
+uint8_t ledmatrix_sending_frame(void) {
+	return sending_frame;
+}
+
+uint16_t ledmatrix_get_frame_period(void) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	uint16_t period = frame_period;
+	if(interrupts_enabled) {
+		sei();
+	}
+	return period;
+}
+
+void ledmatrix_set_frame_rate(uint8_t frames_per_second) {
+	if(frames_per_second == 0) {
+		return;
+	}
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	frame_period = (1000 + frames_per_second / 2) / frames_per_second;
+	ms_until_frame = frame_period;
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void ledmatrix_get_stats(LedMatrixStats* frame_stats) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	*frame_stats = stats;
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void ledmatrix_reset_stats(void) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	stats = (LedMatrixStats){0};
+	if(interrupts_enabled) {
+		sei();
+	}
 }
 
 void ledmatrix_update_all(MatrixData data) {
-	(void)spi_send_byte(CMD_UPDATE_ALL);
-	for(uint8_t y=0; y<MATRIX_NUM_ROWS; y++) {
-		for(uint8_t x=0; x<MATRIX_NUM_COLUMNS; x++) {
-			(void)spi_send_byte(data[x][y]);
+	for(uint8_t x=0; x<MATRIX_NUM_COLUMNS; x++) {
+		for(uint8_t y=0; y<MATRIX_NUM_ROWS; y++) {
+			set_pixel(x, y, data[x][y]);
 		}
 	}
 }
@@ -38,9 +362,14 @@ void ledmatrix_update_pixel(uint8_t x, uint8_t y, PixelColour pixel) {
 		// Position isn't valid - we ignore the request.
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_PIXEL);
-	(void)spi_send_byte( ((y & 0x07)<<4) | (x & 0x0F));
-	(void)spi_send_byte(pixel);
+	set_pixel(x, y, pixel);
+}
+
+PixelColour ledmatrix_get_pixel(uint8_t x, uint8_t y) {
+	if(x >= MATRIX_NUM_COLUMNS || y >= MATRIX_NUM_ROWS) {
+		return 0;
+	}
+	return frame[x][y];
 }
 
 void ledmatrix_update_row(uint8_t y, MatrixRow row) {
@@ -48,10 +377,8 @@ void ledmatrix_update_row(uint8_t y, MatrixRow row) {
 		// y value is too large - we ignore the request
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_ROW);
-	(void)spi_send_byte(y & 0x07);	// row number
 	for(uint8_t x = 0; x<MATRIX_NUM_COLUMNS; x++) {
-		(void)spi_send_byte(row[x]);
+		set_pixel(x, y, row[x]);
 	}
 }
 
@@ -60,35 +387,91 @@ void ledmatrix_update_column(uint8_t x, MatrixColumn col) {
 		// x value is too large - we ignore the request
 		return;
 	}
-	(void)spi_send_byte(CMD_UPDATE_COL);
-	(void)spi_send_byte(x & 0x0F); // column number
 	for(uint8_t y = 0; y<MATRIX_NUM_ROWS; y++) {
-		(void)spi_send_byte(col[y]);
+		set_pixel(x, y, col[y]);
+	}
+}
+
+// Shifts are done by the matrix itself, which blanks the row or column
+// shifted in. The framebuffer is shifted to match along with its dirty
+// bits, since pixels not yet sent move with the rest of the display.
+static void shift_display(uint8_t direction) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	if (direction == SHIFT_LEFT) {
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS - 1; x++) {
+			copy_matrix_column(frame[x + 1], frame[x]);
+			dirty_columns[x] = dirty_columns[x + 1];
+		}
+		set_matrix_column_to_colour(frame[MATRIX_NUM_COLUMNS - 1], COLOUR_BLACK);
+		dirty_columns[MATRIX_NUM_COLUMNS - 1] = 0;
+	} else if (direction == SHIFT_RIGHT) {
+		for (uint8_t x = MATRIX_NUM_COLUMNS - 1; x > 0; x--) {
+			copy_matrix_column(frame[x - 1], frame[x]);
+			dirty_columns[x] = dirty_columns[x - 1];
+		}
+		set_matrix_column_to_colour(frame[0], COLOUR_BLACK);
+		dirty_columns[0] = 0;
+	} else {
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			if (direction == SHIFT_UP) {
+				for (uint8_t y = MATRIX_NUM_ROWS - 1; y > 0; y--) {
+					frame[x][y] = frame[x][y - 1];
+				}
+				frame[x][0] = COLOUR_BLACK;
+				dirty_columns[x] <<= 1;
+			} else {
+				for (uint8_t y = 0; y < MATRIX_NUM_ROWS - 1; y++) {
+					frame[x][y] = frame[x][y + 1];
+				}
+				frame[x][MATRIX_NUM_ROWS - 1] = COLOUR_BLACK;
+				dirty_columns[x] >>= 1;
+			}
+		}
+	}
+	if (num_pending_shifts < MAX_PENDING_SHIFTS) {
+		pending_shifts[num_pending_shifts++] = direction;
+	} else {
+		// too many shifts to hold, so just resend everything
+		num_pending_shifts = 0;
+		for (uint8_t x = 0; x < MATRIX_NUM_COLUMNS; x++) {
+			dirty_columns[x] = 0xFF;
+		}
+	}
+	if(interrupts_enabled) {
+		sei();
 	}
 }
 
 void ledmatrix_shift_display_left(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x02);
+	shift_display(SHIFT_LEFT);
 }
 
 void ledmatrix_shift_display_right(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x01);
+	shift_display(SHIFT_RIGHT);
 }
 
 void ledmatrix_shift_display_up(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x08);
+	shift_display(SHIFT_UP);
 }
 
 void ledmatrix_shift_display_down(void) {
-	(void)spi_send_byte(CMD_SHIFT_DISPLAY);
-	(void)spi_send_byte(0x04);
+	shift_display(SHIFT_DOWN);
 }
 
 void ledmatrix_clear(void) {
-	(void)spi_send_byte(CMD_CLEAR_SCREEN);
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	for(uint8_t x = 0; x<MATRIX_NUM_COLUMNS; x++) {
+		set_matrix_column_to_colour(frame[x], COLOUR_BLACK);
+		dirty_columns[x] = 0;
+	}
+	// anything held for this frame is overwritten by the clear
+	clear_pending = 1;
+	num_pending_shifts = 0;
+	if(interrupts_enabled) {
+		sei();
+	}
 }
 
 void copy_matrix_column(MatrixColumn from, MatrixColumn to) {
@@ -42,6 +42,51 @@ void ledmatrix_shift_display_up(void);
 void ledmatrix_shift_display_down(void);
 void ledmatrix_clear(void);
 
+// returns the colour the display will show at (x,y) once the next frame is
+// sent, or 0 if (x,y) isn't on the display
+PixelColour ledmatrix_get_pixel(uint8_t x, uint8_t y);
+
+// Changes made by the functions above are held in a framebuffer and sent
+// to the display together, at most once a frame. Only pixels whose colour
+// changed are sent, using the fewest SPI bytes possible.
+
+// Changes made between these calls are sent in the same frame: frames due
+// in between are held back until ledmatrix_end_update(). Calls may nest.
+void ledmatrix_begin_update(void);
+void ledmatrix_end_update(void);
+
+// frame rate used until ledmatrix_set_frame_rate() is called
+#define LEDMATRIX_DEFAULT_FRAME_RATE 60
+
+// Sends the changes held for the next frame when it is due. This must be
+// called from the timer0 interrupt handler (i.e. every millisecond).
+void ledmatrix_frame_tick(void);
+
+// Returns 1 while a frame is being sent (from the timer0 interrupt, with
+// interrupts enabled), during which interrupt handlers must not change
+// the display.
+uint8_t ledmatrix_sending_frame(void);
+
+// Sets how many frames a second may be sent (1 to 255; the frame
+// period is rounded to a whole number of milliseconds). 0 is ignored.
+void ledmatrix_set_frame_rate(uint8_t frames_per_second);
+
+// Returns the frame period in milliseconds.
+uint16_t ledmatrix_get_frame_period(void);
+
+// Display traffic statistics. A frame overruns when it is due before the
+// previous frame has finished being sent.
+typedef struct {
+	uint32_t frames;			// frames sent
+	uint16_t overruns;			// frames sent late
+	uint8_t last_frame_bytes;	// SPI bytes in the last frame
+	uint8_t max_frame_bytes;	// most SPI bytes in one frame
+	uint32_t total_bytes;		// SPI bytes in all frames
+} LedMatrixStats;
+
+void ledmatrix_get_stats(LedMatrixStats* frame_stats);
+void ledmatrix_reset_stats(void);
+
 // Functions to operate on MatrixRow and MatrixColumn data structures
 void copy_matrix_column(MatrixColumn from, MatrixColumn to);
 void copy_matrix_row(MatrixRow from, MatrixRow to);
@@ -17,13 +17,27 @@
 #include <util/delay.h>
 
 #include "game.h"
+#include "ai.h"
+#include "animation.h"
 #include "display.h"
 #include "ledmatrix.h"
+#include "protocol.h"
 #include "buttons.h"
 #include "serialio.h"
+#include "shell.h"
 #include "terminalio.h"
+#include "termscreen.h"
 #include "timer0.h"
 
+// Serial port speed. The terminal must be set to the same rate. At 250000
+// baud the terminal mirror and protocol events go out 13 times faster than
+// at 19200 (see init_serial_stdio() for the rates which can be used).
+#define SERIAL_BAUD_RATE 250000
+
+// The computer plays as this player. Set to EMPTY_SQUARE for a two player
+// game.
+#define COMPUTER_PLAYER PLAYER_2
+
 // Function prototypes - these are defined below (after main()) in the order
 // given here
 void initialise_hardware(void);
@@ -32,6 +46,9 @@ void new_game(void);
 void play_game(void);
 void handle_game_over(void);
 
+// set if SERIAL_BAUD_RATE couldn't be used
+static int8_t serial_rate_refused;
+
 /////////////////////////////// main //////////////////////////////////
 int main(void) {
 	// Setup hardware and call backs. This will turn on 
@@ -53,9 +70,9 @@ int main(void) {
 void initialise_hardware(void) {
 	ledmatrix_setup();
 	init_button_interrupts();
-	// Setup serial port for 19200 baud communication with no echo
+	// Setup serial port for SERIAL_BAUD_RATE communication with no echo
 	// of incoming characters
-	init_serial_stdio(19200,0);
+	serial_rate_refused = init_serial_stdio(SERIAL_BAUD_RATE,0);
 	
 	init_timer0();
 	
@@ -67,26 +84,33 @@ void start_screen(void) {
 	// Clear terminal screen and output a message
 	clear_terminal();
 	move_terminal_cursor(10,10);
-	printf_P(PSTR("Teeko"));
+	serial_write_P(PSTR("Teeko"), SERIAL_WRITE_WAIT);
 	move_terminal_cursor(10,12);
-	printf_P(PSTR("CSSE2010/7201 project by Tie Wang s4621539"));
+	serial_write_P(PSTR("CSSE2010/7201 project by Tie Wang s4621539"),
+			SERIAL_WRITE_WAIT);
+	if (serial_rate_refused) {
+		move_terminal_cursor(10,14);
+		serial_write_P(PSTR("SERIAL_BAUD_RATE is too far from what the "
+				"clock can make; using 19200 baud"), SERIAL_WRITE_WAIT);
+	}
 	
 	// Output the static start screen and wait for a push button 
 	// to be pushed or a serial input of 's'
 	start_display();
 	
-	// Wait until a button is pressed, or 's' is pressed on the terminal
+	// Wait until a button is pressed, 's' is pressed on the terminal or
+	// a new game is asked for over the binary protocol
 	while(1) {
 		// First check for if a 's' is pressed
 		// There are two steps to this
-		// 1) collect any serial input (if available)
+		// 1) collect any serial input (if available). Protocol frames
+		//    and command lines are dealt with here and don't count as
+		//    input.
 		// 2) check if the input is equal to the character 's'
-		char serial_input = -1;
-		if (serial_input_available()) {
-			serial_input = fgetc(stdin);
-		}
+		int16_t serial_input = shell_poll(0);
 		// If the serial input is 's', then exit the start screen
-		if (serial_input == 's' || serial_input == 'S') {
+		if (serial_input == 's' || serial_input == 'S' ||
+				protocol_new_game_requested()) {
 			break;
 		}
 		// Next check for any button presses
@@ -98,32 +122,56 @@ void start_screen(void) {
 }
 
 void new_game(void) {
-	// Clear the serial terminal
+	// Clear the serial terminal. The board is mirrored there as the game
+	// is played.
 	clear_terminal();
+	init_term_screen();
 	
 	// Initialise the game and display
 	initialise_game();
+	ai_new_game();
+	protocol_new_game_started();
 	
-	// Clear a button push or serial input if any are waiting
-	// (The cast to void means the return value is ignored.)
-	(void)button_pushed();
-	clear_serial_input_buffer();
+	// Clear any button events or terminal input waiting. Protocol
+	// frames are kept, and handled as they are read.
+	button_clear_events();
+	while(shell_poll(0) >= 0) {
+		// discard the character
+	}
 }
 
 void play_game(void) {
 	
 	uint32_t last_flash_time, current_time;
-	uint8_t btn; //the button pushed
+	int8_t btn; //the button pushed
 	
 	last_flash_time = get_current_time();
 	
 	// We play the game until it's over
-	while(!is_game_over()) {
+	while(!is_game_over() && !protocol_new_game_requested()) {
+		
+		// If it's the computer's turn, let it move. The search takes at
+		// most the AI time budget.
+		if (get_current_player() == COMPUTER_PLAYER) {
+			draw_terminal_board(PSTR("Thinking..."));
+			term_screen_flush();
+			ai_play_move();
+			last_flash_time = get_current_time();
+			continue;
+		}
 				
 		// We need to check if any button has been pushed, this will be
-		// NO_BUTTON_PUSHED if no button has been pushed
+		// NO_BUTTON_PUSHED if no button has been pushed. A button held
+		// down repeats, which sweeps the cursor across the board.
 		btn = button_pushed();
 
+		// Any serial input is also collected. A space places (or, once all
+		// pieces are down, picks up and moves) a piece at the cursor, and
+		// 't' changes the colour theme. Moves may also come in as protocol
+		// commands, which are played as they are read, and ':' starts a
+		// command line (see shell.h).
+		int16_t serial_input = shell_poll(1);
+
 		// If a valid button is pushed, then we reset the flash cycle by reset
 		// the last_flash_time
 // 		if (btn != NO_BUTTON_PUSHED) {
@@ -151,6 +199,19 @@ void play_game(void) {
 			move_display_cursor(0, -1);
 			last_flash_time = get_current_time();
 		}
+		// the cursor has been redrawn, which ends the push's latency
+		button_event_handled();
+
+		// Serial input is handled separately from the buttons, so that a
+		// character read in the same pass as a button event isn't lost.
+		if (serial_input == ' ') {
+			piece_placement();
+			last_flash_time = get_current_time();
+		} else if (serial_input == 't' || serial_input == 'T') {
+			// switch to the next colour theme
+			set_display_theme((get_display_theme() + 1) % NUM_THEMES);
+			redraw_board();
+		}
 
 		current_time = get_current_time();
 		if(current_time >= last_flash_time + 500) {
@@ -161,18 +222,41 @@ void play_game(void) {
 			// Update the most recent time the cursor was flashed
 			last_flash_time = current_time;
 		}
+
+		// Mirror the board on the terminal. Only what has changed is sent,
+		// and only as much as the serial output buffer has room for.
+		draw_terminal_board(NULL);
+		term_screen_flush();
 	}
-	// We get here if the game is over.
+	// We get here if the game is over, or a new game was asked for.
 }
 
 void handle_game_over() {
+	// A game abandoned for a new one goes straight on to the new game
+	if (!is_game_over()) {
+		return;
+	}
 	move_terminal_cursor(10,14);
-	printf_P(PSTR("GAME OVER"));
+	serial_write_P(PSTR("GAME OVER"), SERIAL_WRITE_WAIT);
 	move_terminal_cursor(10,15);
-	printf_P(PSTR("Press a button to start again"));
+	serial_write_P(PSTR("Press a button to start again"), SERIAL_WRITE_WAIT);
 	
-	while(button_pushed() == NO_BUTTON_PUSHED) {
-		; // wait
+	// The player who made the last move won. Once the winning pattern
+	// has finished blinking, a banner naming them is scrolled.
+	uint8_t winner = (get_current_player() == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	uint8_t banner_shown = 0;
+	draw_terminal_board(NULL);
+	// A button held down to move the cursor when the game ended mustn't
+	// repeat straight into a new game
+	button_clear_events();
+	while(button_pushed() == NO_BUTTON_PUSHED &&
+			!protocol_new_game_requested()) {
+		(void)shell_poll(0);
+		term_screen_flush();
+		if (!banner_shown && !animation_running()) {
+			show_winner_banner(winner);
+			banner_shown = 1;
+		}
 	}
 	
 }
@@ -0,0 +1,281 @@
+/*
+ * protocol.c
+ *
+ * Framing, checking and dispatch of the binary serial protocol. Input is
+ * COBS decoded a byte at a time as it is taken from the serial input
+ * buffer, with the CRC kept up to date as it goes, so a frame is checked
+ * as soon as its closing 0x00 arrives and nothing ever waits for input.
+ */
+
+#include <stdint.h>
+#include <util/crc16.h>
+
+#include "protocol.h"
+#include "buttons.h"
+#include "game.h"
+#include "ledmatrix.h"
+#include "serialio.h"
+#include "timer0.h"
+
+#define CRC_INITIAL 0xFFFF
+
+// what the incoming bytes are
+#define RX_TERMINAL 0	// terminal input, outside any frame
+#define RX_FRAME 1		// part of a frame
+#define RX_DISCARD 2	// part of a frame too long to keep
+#define RX_SYNC 3		// after a bad frame, waiting for a 0x00 to start
+						// the next
+
+static uint8_t rx_state;
+static uint8_t rx_message[PROTOCOL_MAX_MESSAGE];
+static uint8_t rx_length;
+// bytes left in the current COBS block, and the code which started it
+static uint8_t rx_block_left;
+static uint8_t rx_block_code;
+static uint16_t rx_crc;
+
+static uint8_t host_present;
+static uint8_t new_game_requested;
+static uint16_t bad_frames;
+static uint16_t events_dropped;
+
+static uint8_t* put_uint16(uint8_t* data, uint16_t value) {
+	data[0] = value;
+	data[1] = value >> 8;
+	return data + 2;
+}
+
+static uint8_t* put_uint32(uint8_t* data, uint32_t value) {
+	data = put_uint16(data, value);
+	return put_uint16(data, value >> 16);
+}
+
+// sends the 'length' byte message (which must have room for its CRC after
+// it) if the whole frame fits in the serial output buffer, so frames are
+// never split and sending never waits
+static void send_message(uint8_t* message, uint8_t length) {
+	if (!host_present) {
+		return;
+	}
+	uint16_t crc = CRC_INITIAL;
+	for (uint8_t i = 0; i < length; i++) {
+		crc = _crc_ccitt_update(crc, message[i]);
+	}
+	put_uint16(message + length, crc);
+	length += 2;
+
+	// COBS: each run of non-zero bytes is preceded by its length plus
+	// one, which stands in for the zero after it
+	uint8_t frame[PROTOCOL_MAX_MESSAGE + 3];
+	uint8_t code_position = 1, frame_length = 2;
+	frame[0] = 0;
+	for (uint8_t i = 0; i < length; i++) {
+		if (message[i] == 0) {
+			frame[code_position] = frame_length - code_position;
+			code_position = frame_length++;
+		} else {
+			frame[frame_length++] = message[i];
+		}
+	}
+	frame[code_position] = frame_length - code_position;
+	frame[frame_length++] = 0;
+
+	if (serial_output_space() < frame_length) {
+		events_dropped++;
+		return;
+	}
+	serial_write(frame, frame_length, SERIAL_WRITE_FIT);
+}
+
+static void send_reply(uint8_t command, uint8_t result) {
+	uint8_t message[3 + 2];
+	message[0] = EVENT_REPLY;
+	message[1] = command;
+	message[2] = result;
+	send_message(message, 3);
+}
+
+static void send_state(void) {
+	uint8_t message[PROTOCOL_MAX_MESSAGE];
+	uint8_t* data = message;
+	*data++ = EVENT_STATE;
+	data = put_uint32(data, get_player_pieces(PLAYER_1));
+	data = put_uint32(data, get_player_pieces(PLAYER_2));
+	*data++ = get_current_player();
+	*data++ = get_pieces_placed();
+	*data++ = is_game_over();
+	send_message(message, data - message);
+}
+
+static void send_stats(void) {
+	LedMatrixStats frame_stats;
+	ledmatrix_get_stats(&frame_stats);
+	ButtonStats button_stats;
+	button_get_stats(&button_stats);
+	uint8_t message[PROTOCOL_MAX_MESSAGE];
+	uint8_t* data = message;
+	*data++ = EVENT_STATS;
+	data = put_uint32(data, get_current_time());
+	data = put_uint32(data, frame_stats.frames);
+	data = put_uint16(data, frame_stats.overruns);
+	*data++ = frame_stats.max_frame_bytes;
+	data = put_uint32(data, frame_stats.total_bytes);
+	data = put_uint16(data, bad_frames);
+	data = put_uint16(data, events_dropped);
+	data = put_uint16(data, button_stats.events);
+	data = put_uint16(data, button_stats.dropped);
+	data = put_uint16(data, button_stats.max_latency);
+	send_message(message, data - message);
+}
+
+static uint8_t play_remote_move(uint8_t from, uint8_t to,
+		uint8_t accept_moves) {
+	uint8_t player = get_current_player();
+	if (!accept_moves || is_game_over() ||
+			!is_legal_move(get_player_pieces(player), get_occupied_squares(),
+			get_pieces_placed(), from, to)) {
+		return RESULT_REFUSED;
+	}
+	play_move(from, to);
+	return RESULT_OK;
+}
+
+// carries out the command in rx_message (without its CRC). Returns 1 if
+// it played a move or asked for a new game.
+static uint8_t handle_command(uint8_t length, uint8_t accept_moves) {
+	uint8_t command = rx_message[0];
+	uint8_t result = RESULT_UNKNOWN;
+	uint8_t game_changed = 0;
+	if (command == CMD_NEW_GAME && length == 1) {
+		new_game_requested = 1;
+		result = RESULT_OK;
+		game_changed = 1;
+	} else if (command == CMD_PLACE && length == 2) {
+		result = play_remote_move(NO_SQUARE, rx_message[1], accept_moves);
+		game_changed = (result == RESULT_OK);
+	} else if (command == CMD_MOVE && length == 3) {
+		result = play_remote_move(rx_message[1], rx_message[2], accept_moves);
+		game_changed = (result == RESULT_OK);
+	} else if (command == CMD_QUERY_STATE && length == 1) {
+		send_state();
+		result = RESULT_OK;
+	} else if (command == CMD_QUERY_STATS && length == 1) {
+		send_stats();
+		result = RESULT_OK;
+	}
+	send_reply(command, result);
+	return game_changed;
+}
+
+static void start_frame(void) {
+	rx_state = RX_FRAME;
+	rx_length = 0;
+	rx_block_left = 0;
+	rx_block_code = 0xFF;
+	rx_crc = CRC_INITIAL;
+}
+
+// a message byte has been decoded
+static void add_message_byte(uint8_t byte) {
+	if (rx_length == PROTOCOL_MAX_MESSAGE) {
+		rx_state = RX_DISCARD;
+		return;
+	}
+	rx_message[rx_length++] = byte;
+	rx_crc = _crc_ccitt_update(rx_crc, byte);
+}
+
+// A bad frame may really be the end of one frame and the start of the
+// next, if a delimiter was lost, so once a host has been heard from the
+// bytes up to the next 0x00 are thrown away rather than taken as
+// keystrokes, and that 0x00 starts a frame. Before then the bytes are more
+// likely a stray 0x00 typed at a terminal, so they go back to being
+// terminal input.
+static void reject_frame(void) {
+	rx_state = host_present ? RX_SYNC : RX_TERMINAL;
+	bad_frames++;
+	send_reply(0, RESULT_BAD_FRAME);
+}
+
+// the closing 0x00 of a frame has arrived. A message followed by its CRC
+// leaves a CRC of zero. Returns 1 if the command played a move or asked
+// for a new game.
+static uint8_t end_frame(uint8_t accept_moves) {
+	if (rx_block_left != 0 || rx_length < 3 || rx_crc != 0) {
+		reject_frame();
+		return 0;
+	}
+	rx_state = RX_TERMINAL;
+	host_present = 1;
+	return handle_command(rx_length - 2, accept_moves);
+}
+
+int16_t protocol_poll(uint8_t accept_moves) {
+	int16_t input;
+	while ((input = serial_read_char()) >= 0) {
+		uint8_t byte = input;
+		if (rx_state == RX_TERMINAL) {
+			if (byte != 0) {
+				return byte;
+			}
+			start_frame();
+		} else if (byte == 0) {
+			if (rx_state == RX_SYNC) {
+				start_frame();
+			} else if (rx_state == RX_DISCARD) {
+				// too long to have been checked, so just reject it
+				reject_frame();
+			} else if (rx_length == 0 && rx_block_code == 0xFF) {
+				// an empty frame: take this as the start of the next
+				// one, which lets a sender resynchronise
+				start_frame();
+			} else if (end_frame(accept_moves)) {
+				// the rest of the input is left until the caller has seen
+				// the change, so a second move in the buffer isn't played
+				// for whoever moves next, nor a move for the old game
+				// after a new one is asked for
+				return -1;
+			}
+		} else if (rx_state == RX_FRAME) {
+			if (rx_block_left == 0) {
+				// a new block: the last one ended with a zero, unless it
+				// was a full block of 254 bytes (or this is the first)
+				if (rx_block_code != 0xFF) {
+					add_message_byte(0);
+				}
+				rx_block_code = byte;
+				rx_block_left = byte - 1;
+			} else {
+				add_message_byte(byte);
+				rx_block_left--;
+			}
+		}
+	}
+	return -1;
+}
+
+void protocol_get_stats(uint16_t* bad_frame_count,
+		uint16_t* dropped_event_count) {
+	*bad_frame_count = bad_frames;
+	*dropped_event_count = events_dropped;
+}
+
+uint8_t protocol_new_game_requested(void) {
+	return new_game_requested;
+}
+
+void protocol_new_game_started(void) {
+	new_game_requested = 0;
+	send_state();
+}
+
+void protocol_board_changed(void) {
+	send_state();
+	if (is_game_over()) {
+		uint8_t message[2 + 2];
+		message[0] = EVENT_GAME_OVER;
+		// the player who just moved won
+		message[1] = (get_current_player() == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+		send_message(message, 2);
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * protocol.h
+ *
+ * A binary protocol on the serial port for test rigs and programs which
+ * play the game, sharing the port with the terminal.
+ *
+ * Each message is sent as a frame: a 0x00 byte, the message COBS encoded
+ * (so it holds no 0x00 bytes), then another 0x00. Back to back frames each
+ * need their own leading 0x00. Input bytes outside frames are ordinary
+ * terminal input. A decoded message is a type byte, its payload, then a
+ * CRC-16 of both, low byte first: polynomial 0x1021 bit reversed, initial
+ * value 0xFFFF and no final XOR (avr-libc's _crc_ccitt_update(), also
+ * known as CRC-16/MCRF4XX). Multi-byte values are little-endian, and
+ * squares are numbered from 0 (bottom left) to 24 (top right).
+ *
+ * The device only sends events once it has received a valid frame, so a
+ * plain terminal never sees them. After that, a bad frame (which may be
+ * the tail of one frame and the head of the next, if a 0x00 was lost)
+ * makes the device ignore input until the next 0x00, which it takes as
+ * the start of a frame.
+ */
+
+
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+#include <stdint.h>
+
+// longest decoded message, including its type and CRC
+#define PROTOCOL_MAX_MESSAGE 32
+
+// commands, to the device
+#define CMD_NEW_GAME		0x01	// (no payload)
+#define CMD_PLACE			0x02	// square
+#define CMD_MOVE			0x03	// from square, to square
+#define CMD_QUERY_STATE		0x04	// (no payload)
+#define CMD_QUERY_STATS		0x05	// (no payload)
+
+// events, from the device. Every command is answered with EVENT_REPLY;
+// EVENT_STATE is also sent whenever a move is played or a game starts,
+// and EVENT_GAME_OVER when a move wins.
+#define EVENT_REPLY			0x80	// command type (0 if unreadable), result
+#define EVENT_STATE			0x81	// player 1 pieces (4 bytes), player 2
+									// pieces (4), player to move, pieces
+									// placed, game over
+#define EVENT_GAME_OVER		0x82	// winner
+#define EVENT_STATS			0x83	// uptime in ms (4), LED matrix frames
+									// (4), frame overruns (2), most bytes
+									// in a frame (1), frame bytes (4), bad
+									// frames received (2), events dropped
+									// (2), button events (2), button
+									// events dropped (2), most button
+									// latency in ms (2)
+
+// results in EVENT_REPLY
+#define RESULT_OK			0
+#define RESULT_REFUSED		1	// illegal move, or moves not accepted now
+#define RESULT_UNKNOWN		2	// unknown command or wrong payload length
+#define RESULT_BAD_FRAME	3	// bad CRC, COBS encoding or length
+
+// Handle any waiting serial input without waiting for more. Commands are
+// carried out as their frames complete; moves are only played if
+// 'accept_moves' is set. Returns the first terminal input character found
+// (the rest are left for the next call), or -1 if there is none. It also
+// returns -1 straight after a move is played or a new game is asked for,
+// leaving the rest of the input, so that the caller can check whose turn
+// it is before another move is accepted.
+int16_t protocol_poll(uint8_t accept_moves);
+
+// returns how many bad frames have been received and how many events
+// were dropped for lack of room in the serial output buffer
+void protocol_get_stats(uint16_t* bad_frame_count,
+		uint16_t* dropped_event_count);
+
+// returns 1 if a new game has been asked for with CMD_NEW_GAME
+uint8_t protocol_new_game_requested(void);
+
+// call once a new game has been set up: clears any request for one and
+// sends the new state
+void protocol_new_game_started(void);
+
+// call after each move is played: sends the new state, and the winner if
+// the game is over
+void protocol_board_changed(void);
+
+#endif /* PROTOCOL_H_ */
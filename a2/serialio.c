@@ -8,7 +8,9 @@
  * any standard IO methods (e.g. printf). We use interrupt-based output
  * and a circular buffer to store output messages. (This allows us 
  * to print many characters at once to the buffer and have them 
- * output by the UART as speed permits.) If the buffer fills up, the
+ * output by the UART as speed permits.) Each buffer has one writer and
+ * one reader (the main program or an ISR), so neither side ever has to
+ * disable interrupts to use it. If the output buffer fills up, the
  * put method will either
  * (1) if interrupts are enabled, block until there is room in it, or
  * (2) if interrupts are disabled, will discard the character.
@@ -23,37 +25,53 @@
 #include "serialio.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 /* System clock rate in Hz. (L at the end indicates this is a long constant) */
 #define SYSCLK 8000000L
 
 /* Global variables */
-/* Circular buffer to hold outgoing characters. The insert_pos variable
- * keeps track of the position (0 to OUTPUT_BUFFER_SIZE-1) that the next
- * outgoing character should be written to. bytes_in_buffer keeps
- * count of the number of characters currently stored in the buffer 
- * (ranging from 0 to OUTPUT_BUFFER_SIZE). This number of bytes immediately
- * prior to the current insert_pos are the bytes waiting to be output.
- * If the insert_pos reaches the end of the buffer it will wrap around
- * to the beginning (assuming those bytes have been output).
- * NOTE - OUTPUT_BUFFER_SIZE can not be larger than 255 without changing
- * the type of the variables below (currently defined as 8 bit unsigned ints).
+/* Circular buffer to hold outgoing characters. The main program adds
+ * characters at out_head and the UDR empty ISR removes them from out_tail.
+ * Each index is only ever written by one side, and an 8 bit write is
+ * atomic, so no interrupts need to be disabled. The indices run freely
+ * (wrapping at 256) and are masked to index the buffer, so the buffer
+ * size must be a power of two no larger than 256, and head - tail is the
+ * number of characters waiting. With a 256 character buffer one slot is
+ * left unused so that a full buffer can be told from an empty one.
  */
-#define OUTPUT_BUFFER_SIZE 255
+#define OUTPUT_BUFFER_SIZE 256
+#define OUTPUT_BUFFER_MASK (OUTPUT_BUFFER_SIZE - 1)
+#define OUTPUT_BUFFER_CAPACITY (OUTPUT_BUFFER_SIZE - 1)
 volatile char out_buffer[OUTPUT_BUFFER_SIZE];
-volatile uint8_t out_insert_pos;
-volatile uint8_t bytes_in_out_buffer;
+volatile uint8_t out_head;
+volatile uint8_t out_tail;
 
 /* Circular buffer to hold incoming characters. Works on same principle
- * as output buffer
+ * as output buffer, with the receive ISR adding characters and the main
+ * program removing them.
  */
-#define INPUT_BUFFER_SIZE 16
+#define INPUT_BUFFER_SIZE 64
+#define INPUT_BUFFER_MASK (INPUT_BUFFER_SIZE - 1)
 volatile char input_buffer[INPUT_BUFFER_SIZE];
-volatile uint8_t input_insert_pos;
-volatile uint8_t bytes_in_input_buffer;
-volatile uint8_t input_overrun;
+volatile uint8_t input_head;
+volatile uint8_t input_tail;
+
+/* Count of received characters which were lost, either because the
+ * input buffer was full or because the UART overran (a character arrived
+ * before the ISR read the one before it). Only the receive ISR changes it.
+ */
+volatile uint16_t input_overruns;
+
+/* The baud rate the UART is actually running at, and how far that is from
+ * the rate asked for (in tenths of a percent).
+ */
+static uint32_t actual_baud_rate;
+static int16_t baud_rate_error;
 
 /* Variable to keep track of whether incoming characters are to be echoed
  * back or not.
@@ -62,7 +80,7 @@ static int8_t do_echo;
 
 /* Function prototypes 
  */
-void init_serial_stdio(long baudrate, int8_t echo);
+int8_t init_serial_stdio(long baudrate, int8_t echo);
 static int uart_put_char(char, FILE*);
 static int uart_get_char(FILE*);
 
@@ -72,29 +90,91 @@ static int uart_get_char(FILE*);
 static FILE myStream = FDEV_SETUP_STREAM(uart_put_char, uart_get_char,
 		_FDEV_SETUP_RW);
 
-void init_serial_stdio(long baudrate, int8_t echo) {
-	uint16_t ubrr;
+/* The UART divides the system clock by 16 (or by 8 in double speed mode)
+ * and then by UBRR + 1 to get the baud rate. Returns the error (in tenths
+ * of a percent) of the rate closest to 'baudrate' for the given divisor,
+ * with its UBRR value and actual rate.
+ */
+static int16_t baud_rate_setting(uint32_t baudrate, uint8_t divisor,
+		uint16_t* ubrr, uint32_t* actual) {
+	/* Round to the nearest UBRR value using integer division (which
+	 * truncates), and keep within the 12 bits of UBRR0.
+	*/
+	uint32_t divider = (SYSCLK + (uint32_t)divisor * baudrate / 2) /
+			((uint32_t)divisor * baudrate);
+	if(divider < 1) {
+		divider = 1;
+	} else if(divider > 4096) {
+		divider = 4096;
+	}
+	*ubrr = divider - 1;
+	*actual = SYSCLK / ((uint32_t)divisor * divider);
+	int32_t difference = ((int32_t)*actual - (int32_t)baudrate) * 1000;
+	int32_t half = (difference < 0) ? -(int32_t)baudrate / 2 : baudrate / 2;
+	return (difference + half) / (int32_t)baudrate;
+}
+
+/* Chooses the UBRR value and speed mode which get closest to 'baudrate'
+ * and sets the UART to use them. Returns 0, or 1 (leaving the UART as it
+ * was) if even the closest rate is more than SERIAL_MAX_BAUD_ERROR out.
+ */
+static int8_t set_baud_rate(uint32_t baudrate) {
+	/* Nothing above the fastest rate the UART can make (which also keeps
+	 * the error arithmetic in baud_rate_setting() within 32 bits), and
+	 * no rate of 0, which can't be divided by.
+	*/
+	if(baudrate == 0 || baudrate > SYSCLK / 8) {
+		return 1;
+	}
+	uint16_t ubrr, ubrr_double;
+	uint32_t actual, actual_double;
+	int16_t error = baud_rate_setting(baudrate, 16, &ubrr, &actual);
+	int16_t error_double = baud_rate_setting(baudrate, 8, &ubrr_double,
+			&actual_double);
+	/* Normal speed samples each bit more times, so it is used unless
+	 * double speed is closer.
+	*/
+	uint8_t double_speed = abs(error_double) < abs(error);
+	if(double_speed) {
+		ubrr = ubrr_double;
+		actual = actual_double;
+		error = error_double;
+	}
+	if(abs(error) > SERIAL_MAX_BAUD_ERROR) {
+		return 1;
+	}
+	UBRR0 = ubrr;
+	if(double_speed) {
+		UCSR0A |= (1 << U2X0);
+	} else {
+		UCSR0A &= ~(1 << U2X0);
+	}
+	actual_baud_rate = actual;
+	baud_rate_error = error;
+	return 0;
+}
+
+int8_t init_serial_stdio(long baudrate, int8_t echo) {
 	/*
 	 * Initialise our buffers
 	*/
-	out_insert_pos = 0;
-	bytes_in_out_buffer = 0;
-	input_insert_pos = 0;
-	bytes_in_input_buffer = 0;
-	input_overrun = 0;
+	out_head = 0;
+	out_tail = 0;
+	input_head = 0;
+	input_tail = 0;
+	input_overruns = 0;
 	
 	/*
 	 * Record whether we're going to echo characters or not
 	*/
 	do_echo = echo;
 	
-	/* Configure the serial port baud rate */
-	/* (This differs from the datasheet formula so that we get 
-	 * rounding to the nearest integer while using integer division
-	 * (which truncates)).
-	*/
-	ubrr = ((SYSCLK / (8 * baudrate)) + 1)/2 - 1;
-	UBRR0 = ubrr;
+	/* Configure the serial port baud rate, falling back to a rate
+	 * which can always be made if the one asked for can't be */
+	int8_t result = set_baud_rate(baudrate);
+	if(result) {
+		set_baud_rate(SERIAL_FALLBACK_BAUD_RATE);
+	}
 	
 	/*
 	 * Enable transmission and receiving via UART. We don't enable
@@ -116,100 +196,188 @@ void init_serial_stdio(long baudrate, int8_t echo) {
 	*/
 	stdout = &myStream;
 	stdin = &myStream;
+	return result;
+}
+
+uint32_t serial_baud_rate(void) {
+	return actual_baud_rate;
+}
+
+int16_t serial_baud_rate_error(void) {
+	return baud_rate_error;
 }
 
 int8_t serial_input_available(void) {
-	return (bytes_in_input_buffer != 0);
+	return (input_head != input_tail);
 }
 
 void clear_serial_input_buffer(void) {
-	/* Just adjust our buffer data so it looks empty */
-	input_insert_pos = 0;
-	bytes_in_input_buffer = 0;
+	/* Just move our read position up to the write position so the
+	 * buffer looks empty (the read position is ours to change) */
+	input_tail = input_head;
 }
 
-static int uart_put_char(char c, FILE* stream) {
-	uint8_t interrupts_enabled;
-	
-	/* Add the character to the buffer for transmission (if there 
-	 * is space to do so). If not we wait until the buffer has space.
-	 * If the character is \n, we output \r (carriage return)
-	 * also.
-	*/
-	if(c == '\n') {
-		uart_put_char('\r', stream);
-	}
-	
+uint8_t serial_output_space(void) {
+	return OUTPUT_BUFFER_CAPACITY - (uint8_t)(out_head - out_tail);
+}
+
+int8_t serial_put_char(char c) {
 	/* If the buffer is full and interrupts are disabled then we
 	 * abort - we don't output the character since the buffer will
 	 * never be emptied if interrupts are disabled. If the buffer is full
 	 * and interrupts are enabled then we loop until the buffer has 
-	 * enough space. The bytes_in_buffer variable will get modified by the
-	 * ISR which extracts bytes from the buffer.
+	 * enough space. out_tail will get modified by the ISR which
+	 * extracts bytes from the buffer.
 	*/
-	interrupts_enabled = bit_is_set(SREG, SREG_I);
-	while(bytes_in_out_buffer >= OUTPUT_BUFFER_SIZE) {
-		if(!interrupts_enabled) {
+	uint8_t head = out_head;
+	while((uint8_t)(head - out_tail) >= OUTPUT_BUFFER_CAPACITY) {
+		if(!bit_is_set(SREG, SREG_I)) {
 			return 1;
 		}		
 		/* else do nothing */
 	}
 	
-	/* Add the character to the buffer for transmission if there
-	 * is space to do so. We advance the insert_pos to the next
-	 * character position. If this is beyond the end of the buffer
-	 * we wrap around back to the beginning of the buffer 
-	 * NOTE: we disable interrupts before modifying the buffer. This
-	 * prevents the ISR from modifying the buffer at the same time.
-	 * We reenable them if they were enabled when we entered the
-	 * function.
+	/* Store the character, then publish it by advancing out_head. The
+	 * ISR never looks past out_head, so it can't see the slot before
+	 * the character is in it.
 	*/	
-	cli();
-	out_buffer[out_insert_pos++] = c;
-	bytes_in_out_buffer++;
-	if(out_insert_pos == OUTPUT_BUFFER_SIZE) {
-		/* Wrap around buffer pointer if necessary */
-		out_insert_pos = 0;
-	}
-	/* Reenable interrupts (UDR Empty interrupt may have been
-	 * disabled) - we ensure it is now enabled so that it will
-	 * fire and deal with the next character in the buffer. */
+	out_buffer[head & OUTPUT_BUFFER_MASK] = c;
+	out_head = head + 1;
+	
+	/* Make sure the UDR Empty interrupt is enabled so that it will fire
+	 * and deal with the next character in the buffer. The ISR only ever
+	 * clears this bit when it finds the buffer empty, so if it runs in
+	 * the middle of this read-modify-write the worst case is one extra
+	 * interrupt which finds nothing to send. */
 	UCSR0B |= (1 << UDRIE0);
-	if(interrupts_enabled) {
-		sei();
+	return 0;
+}
+
+/* Returns how many characters can be added from out_head (taken as a
+ * copy, since only we change it) to the end of the buffer, or until it
+ * is full, whichever comes first.
+ */
+static uint8_t output_run(uint8_t head) {
+	uint8_t space = OUTPUT_BUFFER_CAPACITY - (uint8_t)(head - out_tail);
+	uint16_t to_end = OUTPUT_BUFFER_SIZE - (head & OUTPUT_BUFFER_MASK);
+	return (space < to_end) ? space : to_end;
+}
+
+/* Waits for room in the output buffer, as serial_put_char() does. Returns
+ * 0 if there is room, or 1 if there is none and waiting is not allowed.
+ */
+static uint8_t wait_for_output_space(uint8_t mode) {
+	while(serial_output_space() == 0) {
+		if(mode == SERIAL_WRITE_FIT || !bit_is_set(SREG, SREG_I)) {
+			return 1;
+		}
 	}
 	return 0;
 }
 
+uint16_t serial_write(const void* data, uint16_t length, uint8_t mode) {
+	const char* bytes = data;
+	uint16_t written = 0;
+	while(written < length && !wait_for_output_space(mode)) {
+		/* Copy as much as fits in one go, then publish it all with a
+		 * single update of out_head. */
+		uint8_t head = out_head;
+		uint16_t count = output_run(head);
+		if(count > length - written) {
+			count = length - written;
+		}
+		memcpy((char*)&out_buffer[head & OUTPUT_BUFFER_MASK],
+				bytes + written, count);
+		/* memcpy's stores aren't volatile, so the compiler could move
+		 * them after the update of out_head, letting the UDR empty ISR
+		 * send the bytes before they are there. This barrier stops it. */
+		__asm__ __volatile__("" ::: "memory");
+		out_head = head + count;
+		UCSR0B |= (1 << UDRIE0);
+		written += count;
+	}
+	return written;
+}
+
+uint16_t serial_write_P(const char* text, uint8_t mode) {
+	uint16_t written = 0;
+	char c = pgm_read_byte(text);
+	while(c != '\0' && !wait_for_output_space(mode)) {
+		uint8_t head = out_head;
+		uint8_t count = output_run(head);
+		uint8_t copied = 0;
+		while(copied < count && c != '\0') {
+			out_buffer[(head + copied) & OUTPUT_BUFFER_MASK] = c;
+			copied++;
+			c = pgm_read_byte(++text);
+		}
+		out_head = head + copied;
+		UCSR0B |= (1 << UDRIE0);
+		written += copied;
+	}
+	return written;
+}
+
+static int uart_put_char(char c, FILE* stream) {
+	/* Add the character to the buffer for transmission. If the
+	 * character is \n, we output \r (carriage return) also.
+	*/
+	if(c == '\n') {
+		serial_put_char('\r');
+	}
+	return serial_put_char(c);
+}
+
+uint16_t serial_input_overruns(void) {
+	/* The ISR may change the count between reading its two bytes, so
+	 * read it until the same value is seen twice.
+	 */
+	uint16_t count;
+	do {
+		count = input_overruns;
+	} while(count != input_overruns);
+	return count;
+}
+
+int16_t serial_read_char(void) {
+	uint8_t tail = input_tail;
+	if(tail == input_head) {
+		return -1;
+	}
+	char c = input_buffer[tail & INPUT_BUFFER_MASK];
+	input_tail = tail + 1;
+	return (uint8_t)c;
+}
+
 int uart_get_char(FILE* stream) {
 	/* Wait until we've received a character */
-	while(bytes_in_input_buffer == 0) {
+	while(input_head == input_tail) {
 		/* do nothing */
 	}
 	
 	/*
-	 * Turn interrupts off and remove a character from the input
-	 * buffer. We reenable interrupts if they were on.
-	 * The pending character is the one which is byte_in_input_buffer
-	 * characters before the insert position (taking into account
-	 * that we may need to wrap around).
+	 * Take the character at the read position, then advance it, which
+	 * frees the slot for the receive ISR. Only this function (and
+	 * clear_serial_input_buffer) change input_tail.
 	 */
-	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
-	cli();
-	char c;
-	if(input_insert_pos - bytes_in_input_buffer < 0) {
-		/* Need to wrap around */
-		c = input_buffer[input_insert_pos - bytes_in_input_buffer
-				+ INPUT_BUFFER_SIZE];
-	} else {
-		c = input_buffer[input_insert_pos - bytes_in_input_buffer];
+	uint8_t tail = input_tail;
+	char c = input_buffer[tail & INPUT_BUFFER_MASK];
+	input_tail = tail + 1;
+	
+	/* If the character is a carriage return, turn it into a
+	 * linefeed. (The buffer holds characters as they were received,
+	 * since serial_read_char() returns them unchanged.)
+	*/
+	if (c == '\r') {
+		c = '\n';
 	}
 	
-	/* Decrement our count of bytes in the input buffer */
-	bytes_in_input_buffer--;
-	if(interrupts_enabled) {
-		sei();
-	}	
+	/* Echo the character if required. This is done here rather than in
+	 * the receive ISR so that the output buffer only has one writer.
+	 */
+	if(do_echo) {
+		uart_put_char(c, stream);
+	}
 	return c;
 }
 
@@ -220,28 +388,13 @@ int uart_get_char(FILE* stream) {
 ISR(USART0_UDRE_vect) 
 {
 	/* Check if we have data in our buffer */
-	if(bytes_in_out_buffer > 0) {
-		/* Yes we do - remove the pending byte and output it
-		 * via the UART. The pending byte (character) is the
-		 * one which is "bytes_in_buffer" characters before the 
-		 * insert_pos (taking into account that we may 
-		 * need to wrap around to the end of the buffer).
+	uint8_t tail = out_tail;
+	if(tail != out_head) {
+		/* Yes we do - output the byte at the read position via the
+		 * UART, then advance the read position to free its slot.
 		 */
-		char c;
-		if(out_insert_pos - bytes_in_out_buffer < 0) {
-			/* Need to wrap around */
-			c = out_buffer[out_insert_pos - bytes_in_out_buffer
-				+ OUTPUT_BUFFER_SIZE];
-		} else {
-			c = out_buffer[out_insert_pos - bytes_in_out_buffer];
-		}
-		/* Decrement our count of the number of bytes in the 
-		 * buffer 
-		 */
-		bytes_in_out_buffer--;
-		
-		/* Output the character via the UART */
-		UDR0 = c;
+		UDR0 = out_buffer[tail & OUTPUT_BUFFER_MASK];
+		out_tail = tail + 1;
 	} else {
 		/* No data in the buffer. We disable the UART Data
 		 * Register Empty interrupt because otherwise it 
@@ -261,43 +414,28 @@ ISR(USART0_UDRE_vect)
 
 ISR(USART0_RX_vect) 
 {
-	/* Read the character - we ignore the possibility of overrun. */
+	/* Read the character, counting any characters the UART lost
+	 * before it (the overrun flag must be read before the data).
+	 */
 	char c;
-	c = UDR0;
-		
-	if(do_echo && bytes_in_out_buffer < OUTPUT_BUFFER_SIZE) {
-		/* If echoing is enabled and there is output buffer
-		 * space, echo the received character back to the UART.
-		 * (If there is no output buffer space, characters
-		 * will be lost.)
-		 */
-		uart_put_char(c, 0);
+	if(UCSR0A & (1 << DOR0)) {
+		input_overruns++;
 	}
+	c = UDR0;
 	
 	/* 
-	 * Check if we have space in our buffer. If not, set the overrun
-	 * flag and throw away the character. (We never clear the 
-	 * overrun flag - it's up to the programmer to check/clear
-	 * this flag if desired.)
+	 * Check if we have space in our buffer. If not, count the
+	 * overrun and throw away the character.
 	 */
-	if(bytes_in_input_buffer >= INPUT_BUFFER_SIZE) {
-		input_overrun = 1;
+	uint8_t head = input_head;
+	if((uint8_t)(head - input_tail) >= INPUT_BUFFER_SIZE) {
+		input_overruns++;
 	} else {
-		/* If the character is a carriage return, turn it into a
-		 * linefeed 
-		*/
-		if (c == '\r') {
-			c = '\n';
-		}
-		
 		/* 
-		 * There is room in the input buffer 
+		 * There is room in the input buffer. Store the character,
+		 * then publish it by advancing the write position.
 		 */
-		input_buffer[input_insert_pos++] = c;
-		bytes_in_input_buffer++;
-		if(input_insert_pos == INPUT_BUFFER_SIZE) {
-			/* Wrap around buffer pointer if necessary */
-			input_insert_pos = 0;
-		}
+		input_buffer[head & INPUT_BUFFER_MASK] = c;
+		input_head = head + 1;
 	}
 }
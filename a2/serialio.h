@@ -19,12 +19,30 @@
 
 #include <stdint.h>
 
+/* The most a baud rate may be out by (in tenths of a percent) before
+ * init_serial_stdio() refuses it, and the rate it uses instead (which is
+ * 0.2% out with the 8MHz clock).
+ */
+#define SERIAL_MAX_BAUD_ERROR 20
+#define SERIAL_FALLBACK_BAUD_RATE 19200
+
 /* Initialise serial IO using the UART. baudrate specifies the desired
  * baud rate (e.g. 19200) and echo determines whether incoming characters
  * are echoed back to the UART output as they are received (zero means no
- * echo, non-zero means echo)
+ * echo, non-zero means echo). The UART's double speed mode is used if it
+ * gets closer to the rate, which makes rates up to 1000000 possible
+ * (e.g. 250000 and 500000 are exact). Returns 0, or 1 if the rate can't
+ * be made closely enough (or is 0, negative or over 1000000), in which
+ * case SERIAL_FALLBACK_BAUD_RATE is used.
  */
-void init_serial_stdio(long baudrate, int8_t echo);
+int8_t init_serial_stdio(long baudrate, int8_t echo);
+
+/* Return the baud rate the UART is running at, and how far that is from
+ * the rate asked for in tenths of a percent (e.g. 2 for 38461 baud when
+ * 38400 was asked for).
+ */
+uint32_t serial_baud_rate(void);
+int16_t serial_baud_rate_error(void);
 
 /* Test if input is available from the serial port. Return 0 if not,
  * non-zero otherwise. If there is input available then it can be read
@@ -32,10 +50,54 @@ void init_serial_stdio(long baudrate, int8_t echo);
  */
 int8_t serial_input_available(void);
 
+/* Return the next character of input (0 to 255), or -1 if there is
+ * none. Unlike the standard IO functions this never waits, and the
+ * character is returned as it was received: it is not echoed, and a
+ * carriage return is not turned into a linefeed.
+ */
+int16_t serial_read_char(void);
+
+/* Return how many received characters have been lost since
+ * init_serial_stdio() because they arrived faster than they were read.
+ */
+uint16_t serial_input_overruns(void);
+
 /* Discard any input waiting to be read from the serial port. (Characters may
  * have been typed when we didn't want them - clear them.
  */
 void clear_serial_input_buffer(void);
 
+/* Return how many characters can be output without waiting for the
+ * UART to make room in the output buffer.
+ */
+uint8_t serial_output_space(void);
+
+/* Output the character c as is (without stdio, and without turning \n
+ * into \r\n). Like the stdio output functions, this waits for room in the
+ * output buffer if interrupts are enabled, and otherwise discards the
+ * character and returns 1. Returns 0 if the character was buffered.
+ */
+int8_t serial_put_char(char c);
+
+/* Modes for serial_write() and serial_write_P(). SERIAL_WRITE_WAIT waits
+ * for room in the output buffer like serial_put_char() (so everything is
+ * written unless interrupts are disabled). SERIAL_WRITE_FIT writes only
+ * what fits in the buffer now and never waits.
+ */
+#define SERIAL_WRITE_WAIT 0
+#define SERIAL_WRITE_FIT 1
+
+/* Output 'length' bytes from 'data' as they are, copying them into the
+ * output buffer in blocks rather than a character at a time. Returns the
+ * number of bytes written.
+ */
+uint16_t serial_write(const void* data, uint16_t length, uint8_t mode);
+
+/* Output the NUL terminated string 'text' from program memory (e.g. made
+ * with PSTR()) as it is, in the same way as serial_write(). Returns the
+ * number of characters written.
+ */
+uint16_t serial_write_P(const char* text, uint8_t mode);
+
 
 #endif /* SERIALIO_H_ */
\ No newline at end of file
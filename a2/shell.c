@@ -0,0 +1,331 @@
+/*
+ * shell.c
+ *
+ * Line editing and commands for the serial terminal's command line. The
+ * line is kept here as it is typed and only parsed once Enter is pressed.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#include "shell.h"
+#include "ai.h"
+#include "buttons.h"
+#include "game.h"
+#include "ledmatrix.h"
+#include "protocol.h"
+#include "serialio.h"
+#include "terminalio.h"
+#include "timer0.h"
+
+// terminal row of the command line, and how many rows under it are used
+// for the output of commands
+#define SHELL_ROW 18
+#define SHELL_OUTPUT_ROWS 5
+
+#define SHELL_LINE_LENGTH 40
+
+#define KEY_BACKSPACE 0x08
+#define KEY_DELETE 0x7F
+#define KEY_ESCAPE 0x1B
+
+static char line[SHELL_LINE_LENGTH + 1];
+static uint8_t line_length;
+static uint8_t editing;
+static uint8_t output_row;
+
+static void write_P(const char* text) {
+	serial_write_P(text, SERIAL_WRITE_WAIT);
+}
+
+// moves to the start of the next output row and clears it
+static void start_output_line(void) {
+	if (output_row < SHELL_OUTPUT_ROWS) {
+		output_row++;
+	}
+	move_terminal_cursor(1, SHELL_ROW + output_row);
+	clear_to_end_of_line();
+}
+
+static void clear_output(void) {
+	for (uint8_t row = 1; row <= SHELL_OUTPUT_ROWS; row++) {
+		move_terminal_cursor(1, SHELL_ROW + row);
+		clear_to_end_of_line();
+	}
+	output_row = 0;
+}
+
+// returns the next word of the line, moving *rest past it, or NULL if
+// there are no more
+static char* next_word(char** rest) {
+	char* word = *rest;
+	while (*word == ' ') {
+		word++;
+	}
+	if (*word == '\0') {
+		return NULL;
+	}
+	char* end = word;
+	while (*end != ' ' && *end != '\0') {
+		end++;
+	}
+	if (*end != '\0') {
+		*end++ = '\0';
+	}
+	*rest = end;
+	return word;
+}
+
+// reads a decimal number no bigger than 'max' from 'word' into *value.
+// Returns 1 if 'word' is such a number, 0 otherwise.
+static uint8_t parse_number(const char* word, uint32_t max, uint32_t* value) {
+	if (word == NULL || *word == '\0') {
+		return 0;
+	}
+	uint32_t n = 0;
+	for (; *word != '\0'; word++) {
+		if (*word < '0' || *word > '9') {
+			return 0;
+		}
+		n = n * 10 + (*word - '0');
+		if (n > max) {
+			return 0;
+		}
+	}
+	*value = n;
+	return 1;
+}
+
+static void command_ai(char* rest) {
+	char* word = next_word(&rest);
+	uint32_t budget;
+	if (word != NULL) {
+		if (!parse_number(word, UINT16_MAX, &budget) || budget == 0) {
+			start_output_line();
+			write_P(PSTR("Usage: ai [1-65535 ms]"));
+			return;
+		}
+		ai_set_time_budget(budget);
+	}
+	start_output_line();
+	write_P(PSTR("AI time budget "));
+	write_terminal_number(ai_get_time_budget());
+	write_P(PSTR(" ms"));
+}
+
+static void command_fps(char* rest) {
+	uint32_t rate;
+	start_output_line();
+	if (!parse_number(next_word(&rest), UINT8_MAX, &rate) || rate == 0) {
+		write_P(PSTR("Usage: fps 1-255"));
+		return;
+	}
+	// the setter takes any rate in this range, but rounds the period to
+	// whole milliseconds, so the period actually used is shown too
+	ledmatrix_set_frame_rate(rate);
+	write_P(PSTR("LED matrix frame rate "));
+	write_terminal_number(rate);
+	write_P(PSTR(" (a frame every "));
+	write_terminal_number(ledmatrix_get_frame_period());
+	write_P(PSTR(" ms)"));
+}
+
+static void command_repeat(char* rest) {
+	char* delay_word = next_word(&rest);
+	uint32_t delay, interval;
+	if (delay_word != NULL) {
+		if (!parse_number(delay_word, UINT16_MAX, &delay) ||
+				!parse_number(next_word(&rest), UINT16_MAX, &interval) ||
+				interval == 0) {
+			start_output_line();
+			write_P(PSTR("Usage: repeat [delay interval] (ms, delay 0 for off)"));
+			return;
+		}
+		button_set_repeat(delay, interval);
+	}
+	uint16_t repeat_delay, repeat_interval;
+	button_get_repeat(&repeat_delay, &repeat_interval);
+	start_output_line();
+	if (repeat_delay == 0) {
+		write_P(PSTR("Held buttons don't repeat"));
+		return;
+	}
+	write_P(PSTR("Held buttons repeat after "));
+	write_terminal_number(repeat_delay);
+	write_P(PSTR(" ms, every "));
+	write_terminal_number(repeat_interval);
+	write_P(PSTR(" ms"));
+}
+
+static void command_stats(void) {
+	LedMatrixStats frame_stats;
+	ledmatrix_get_stats(&frame_stats);
+	uint16_t bad_frames, events_dropped;
+	protocol_get_stats(&bad_frames, &events_dropped);
+	ButtonStats button_stats;
+	button_get_stats(&button_stats);
+
+	start_output_line();
+	write_P(PSTR("Up "));
+	write_terminal_number(get_current_time());
+	write_P(PSTR(" ms, AI budget "));
+	write_terminal_number(ai_get_time_budget());
+	write_P(PSTR(" ms"));
+	start_output_line();
+	write_P(PSTR("LED frames "));
+	write_terminal_number(frame_stats.frames);
+	write_P(PSTR(", late "));
+	write_terminal_number(frame_stats.overruns);
+	write_P(PSTR(", bytes "));
+	write_terminal_number(frame_stats.total_bytes);
+	write_P(PSTR(" (most "));
+	write_terminal_number(frame_stats.max_frame_bytes);
+	write_P(PSTR(")"));
+	start_output_line();
+	int16_t error = serial_baud_rate_error();
+	write_P(PSTR("Serial "));
+	write_terminal_number(serial_baud_rate());
+	write_P((error < 0) ? PSTR(" baud (-") : PSTR(" baud (+"));
+	write_terminal_decimal(abs(error), 1);
+	write_P(PSTR("% out), input lost "));
+	write_terminal_number(serial_input_overruns());
+	start_output_line();
+	write_P(PSTR("Protocol bad frames "));
+	write_terminal_number(bad_frames);
+	write_P(PSTR(", events dropped "));
+	write_terminal_number(events_dropped);
+	start_output_line();
+	write_P(PSTR("Buttons "));
+	write_terminal_number(button_stats.events);
+	write_P(PSTR(" events, "));
+	write_terminal_number(button_stats.dropped);
+	write_P(PSTR(" dropped, latency "));
+	write_terminal_number(button_stats.last_latency);
+	write_P(PSTR(" ms (most "));
+	write_terminal_number(button_stats.max_latency);
+	write_P(PSTR(", average "));
+	write_terminal_number(button_stats.average_latency);
+	write_P(PSTR(")"));
+}
+
+static void command_load(char* rest, uint8_t accept_moves) {
+	char* board = next_word(&rest);
+	char* player_word = next_word(&rest);
+	start_output_line();
+	if (!accept_moves) {
+		write_P(PSTR("Positions can only be loaded during a game"));
+		return;
+	}
+	if (board == NULL || strlen(board) != NUM_SQUARES) {
+		write_P(PSTR("Usage: load board [player]"));
+		return;
+	}
+	Bitboard p1_pieces = 0, p2_pieces = 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if (board[square] == '1') {
+			p1_pieces |= (Bitboard)1 << square;
+		} else if (board[square] == '2') {
+			p2_pieces |= (Bitboard)1 << square;
+		} else if (board[square] != '.') {
+			write_P(PSTR("Squares must be '.', '1' or '2'"));
+			return;
+		}
+	}
+	// as teeko-query does, the player to move defaults to whoever's turn
+	// it is in the drop phase, and to player 1 in the movement phase
+	uint32_t player = PLAYER_1;
+	if (player_word != NULL) {
+		if (!parse_number(player_word, PLAYER_2, &player) ||
+				player < PLAYER_1) {
+			write_P(PSTR("Player must be 1 or 2"));
+			return;
+		}
+	} else if (count_pieces(p1_pieces) > count_pieces(p2_pieces)) {
+		player = PLAYER_2;
+	}
+	if (!load_position(p1_pieces, p2_pieces, player)) {
+		write_P(PSTR("That position can't come up in a game"));
+		return;
+	}
+	write_P(PSTR("Position loaded"));
+}
+
+static void command_help(void) {
+	start_output_line();
+	write_P(PSTR("ai [ms]  fps rate  repeat [delay interval]  stats  help"));
+	start_output_line();
+	write_P(PSTR("load board [player]  (board: 25 of . 1 2)"));
+}
+
+static void run_command(uint8_t accept_moves) {
+	clear_output();
+	line[line_length] = '\0';
+	char* rest = line;
+	char* command = next_word(&rest);
+	if (command == NULL) {
+		return;
+	} else if (strcmp_P(command, PSTR("ai")) == 0) {
+		command_ai(rest);
+	} else if (strcmp_P(command, PSTR("fps")) == 0) {
+		command_fps(rest);
+	} else if (strcmp_P(command, PSTR("repeat")) == 0) {
+		command_repeat(rest);
+	} else if (strcmp_P(command, PSTR("stats")) == 0) {
+		command_stats();
+	} else if (strcmp_P(command, PSTR("load")) == 0) {
+		command_load(rest, accept_moves);
+	} else if (strcmp_P(command, PSTR("help")) == 0) {
+		command_help();
+	} else {
+		start_output_line();
+		write_P(PSTR("Unknown command (try help)"));
+	}
+}
+
+static void end_line(void) {
+	editing = 0;
+	move_terminal_cursor(1, SHELL_ROW);
+	clear_to_end_of_line();
+}
+
+// handles one character typed while a command line is open
+static void edit_line(char c, uint8_t accept_moves) {
+	if (c == '\r' || c == '\n') {
+		end_line();
+		run_command(accept_moves);
+	} else if (c == KEY_ESCAPE) {
+		end_line();
+	} else if (c == KEY_BACKSPACE || c == KEY_DELETE) {
+		if (line_length > 0) {
+			line_length--;
+			move_terminal_cursor(2 + line_length, SHELL_ROW);
+			serial_put_char(' ');
+		}
+	} else if (c >= ' ' && c <= '~' && line_length < SHELL_LINE_LENGTH) {
+		// the cursor may have been moved since the last character, so
+		// each one is put in place
+		move_terminal_cursor(2 + line_length, SHELL_ROW);
+		serial_put_char(c);
+		line[line_length++] = c;
+	}
+}
+
+int16_t shell_poll(uint8_t accept_moves) {
+	int16_t input;
+	while ((input = protocol_poll(accept_moves)) >= 0) {
+		if (editing) {
+			edit_line(input, accept_moves);
+		} else if (input == ':') {
+			editing = 1;
+			line_length = 0;
+			move_terminal_cursor(1, SHELL_ROW);
+			clear_to_end_of_line();
+			serial_put_char(':');
+		} else {
+			return input;
+		}
+	}
+	return -1;
+}
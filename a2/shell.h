@@ -0,0 +1,38 @@
+/*
+ * shell.h
+ *
+ * A command line on the serial terminal for changing settings while the
+ * game runs. Typing ':' starts a command under the board; Enter runs it,
+ * Backspace edits it and Escape abandons it. Input is handled a character
+ * at a time as it arrives, so the game carries on while a command is
+ * typed.
+ *
+ * Commands:
+ *	ai [ms]				show or set the computer's time budget per move
+ *	fps rate			set the LED matrix frame rate
+ *	repeat [delay interval]
+ *						show or set how long a button is held before it
+ *						repeats, and how often it then repeats (ms; a delay
+ *						of 0 turns repeating off)
+ *	stats				show timing and error counts
+ *	load board [player]	set up a position. 'board' is 25 characters, one
+ *						per square from the bottom left along each row: '.'
+ *						for empty, '1' or '2' for a player's piece (as
+ *						host/teeko-query takes). The player to move can be
+ *						given once all pieces have been dropped.
+ *	help				list the commands
+ */
+
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+#include <stdint.h>
+
+// Handle any waiting serial input without waiting for more, as
+// protocol_poll() does, taking the characters of any command being typed.
+// 'load' is only accepted if 'accept_moves' is set. Returns the first
+// character of other terminal input, or -1 if there is none.
+int16_t shell_poll(uint8_t accept_moves);
+
+#endif /* SHELL_H_ */
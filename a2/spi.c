@@ -2,10 +2,26 @@
  * spi.c
  *
  * Author: Peter Sutton
+ *
+ * Bytes can be sent either directly (spi_send_byte(), which busy waits) or
+ * through a circular queue which the SPI transfer complete interrupt
+ * empties one byte at a time, so the caller can carry on while they go.
  */ 
 
 #include "spi.h"
 #include <avr/io.h>
+#include <avr/interrupt.h>
+
+/* Circular buffer of bytes waiting to be sent. queue_start is the position
+ * of the next byte to send and queue_length the number waiting after it.
+ * transfer_active is set while a byte taken from the queue is being sent.
+ * NOTE - SPI_QUEUE_SIZE must be a power of 2 no larger than 128.
+ */
+#define SPI_QUEUE_SIZE 128
+static volatile uint8_t queue[SPI_QUEUE_SIZE];
+static volatile uint8_t queue_start;
+static volatile uint8_t queue_length;
+static volatile uint8_t transfer_active;
 
 void spi_setup_master(uint8_t clockdivider) {
 	// Set up SPI communication as a master
@@ -20,7 +36,9 @@ void spi_setup_master(uint8_t clockdivider) {
 	// Set up the SPI control registers SPCR and SPSR:
 	// - SPE bit = 1 (SPI is enabled)
 	// - MSTR bit = 1 (Master Mode)
-	SPCR0 = (1<<SPE0)|(1<<MSTR0);
+	// - SPIE bit = 1 (interrupt when a transfer completes, which sends
+	//   the next queued byte)
+	SPCR0 = (1<<SPE0)|(1<<MSTR0)|(1<<SPIE0);
 	
 	// Set SPR0 and SPR1 bits in SPCR and SPI2X bit in SPSR
 	// based on the given clock divider
@@ -55,6 +73,11 @@ void spi_setup_master(uint8_t clockdivider) {
 }
 
 uint8_t spi_send_byte(uint8_t byte) {
+	// Let the queue empty, then stop the interrupt from handling the
+	// transfer complete flag so we can wait on it here.
+	spi_flush();
+	SPCR0 &= ~(1<<SPIE0);
+	
 	// Write out the byte to the SPDR0 register. This will initiate
 	// the transfer. We then wait until the most significant byte of
 	// SPSR0 (SPIF0 bit) is set - this indicates that the transfer is
@@ -65,5 +88,76 @@ uint8_t spi_send_byte(uint8_t byte) {
 	while((SPSR0 & (1<<SPIF0)) == 0) {
 		; // wait
 	}
-	return SPDR0;
+	uint8_t received = SPDR0;
+	SPCR0 |= (1<<SPIE0);
+	return received;
+}
+
+// Start sending the next queued byte, if there is one. Must be called with
+// interrupts disabled, and only when no transfer is in progress.
+static void send_next_byte(void) {
+	if(queue_length) {
+		SPDR0 = queue[queue_start];
+		queue_start = (queue_start + 1) & (SPI_QUEUE_SIZE - 1);
+		queue_length--;
+		transfer_active = 1;
+	} else {
+		transfer_active = 0;
+	}
+}
+
+// With interrupts disabled the transfer complete interrupt can't run, so
+// the flag is checked (and cleared, by reading SPDR0) here instead.
+static void poll_transfer(void) {
+	if(SPSR0 & (1<<SPIF0)) {
+		(void)SPDR0;
+		send_next_byte();
+	}
+}
+
+void spi_queue_byte(uint8_t byte) {
+	// If the queue is full, wait for the interrupt to make room (or make
+	// room ourselves if interrupts are disabled)
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	while(queue_length >= SPI_QUEUE_SIZE) {
+		if(!interrupts_enabled) {
+			poll_transfer();
+		}
+	}
+	
+	// Add the byte with interrupts off so the ISR doesn't change the
+	// queue at the same time, and start sending if the SPI is idle.
+	cli();
+	queue[(queue_start + queue_length) & (SPI_QUEUE_SIZE - 1)] = byte;
+	queue_length++;
+	if(!transfer_active) {
+		send_next_byte();
+	}
+	if(interrupts_enabled) {
+		sei();
+	}
+}
+
+void spi_flush(void) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	while(transfer_active) {
+		if(!interrupts_enabled) {
+			poll_transfer();
+		}
+	}
+}
+
+uint8_t spi_queue_depth(void) {
+	uint8_t interrupts_enabled = bit_is_set(SREG, SREG_I);
+	cli();
+	uint8_t depth = queue_length + transfer_active;
+	if(interrupts_enabled) {
+		sei();
+	}
+	return depth;
+}
+
+ISR(SPI_STC_vect) {
+	// The transfer complete flag is cleared by running this interrupt
+	send_next_byte();
 }
\ No newline at end of file
@@ -15,8 +15,20 @@
 void spi_setup_master(uint8_t clockdivider);
 
 // Send and receive an SPI byte. This function will take at least 8 
-// cyles of the divided clock (i.e. will busy wait).
+// cyles of the divided clock (i.e. will busy wait). Any queued bytes
+// are sent first.
 uint8_t spi_send_byte(uint8_t byte);
 
+// Queue a byte to be sent by the SPI interrupt. This only waits if the
+// queue is full. Bytes received while queued bytes are sent are discarded.
+// If interrupts are disabled the queue is emptied by polling instead.
+void spi_queue_byte(uint8_t byte);
+
+// Wait until every queued byte has been sent.
+void spi_flush(void);
+
+// Returns the number of queued bytes which have not yet been fully sent.
+uint8_t spi_queue_depth(void);
+
 
 #endif /* SPI_H_ */
\ No newline at end of file
@@ -0,0 +1,129 @@
+/*
+ * symmetry.c
+ *
+ * Board symmetries as square permutation tables in flash. A bitboard is
+ * transformed by sending each of its set bits through the table, and since
+ * a position has at most 8 pieces that is only a handful of lookups.
+ */
+
+#include "symmetry.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+// square_maps[s][i] is the square index that square i is sent to by
+// symmetry s
+static const uint8_t square_maps[NUM_SYMMETRIES][NUM_SQUARES] PROGMEM = {
+	{	// SYMMETRY_IDENTITY
+		 0,  1,  2,  3,  4,
+		 5,  6,  7,  8,  9,
+		10, 11, 12, 13, 14,
+		15, 16, 17, 18, 19,
+		20, 21, 22, 23, 24
+	},
+	{	// SYMMETRY_ROTATE_90
+		 4,  9, 14, 19, 24,
+		 3,  8, 13, 18, 23,
+		 2,  7, 12, 17, 22,
+		 1,  6, 11, 16, 21,
+		 0,  5, 10, 15, 20
+	},
+	{	// SYMMETRY_ROTATE_180
+		24, 23, 22, 21, 20,
+		19, 18, 17, 16, 15,
+		14, 13, 12, 11, 10,
+		 9,  8,  7,  6,  5,
+		 4,  3,  2,  1,  0
+	},
+	{	// SYMMETRY_ROTATE_270
+		20, 15, 10,  5,  0,
+		21, 16, 11,  6,  1,
+		22, 17, 12,  7,  2,
+		23, 18, 13,  8,  3,
+		24, 19, 14,  9,  4
+	},
+	{	// SYMMETRY_MIRROR_X
+		 4,  3,  2,  1,  0,
+		 9,  8,  7,  6,  5,
+		14, 13, 12, 11, 10,
+		19, 18, 17, 16, 15,
+		24, 23, 22, 21, 20
+	},
+	{	// SYMMETRY_MIRROR_Y
+		20, 21, 22, 23, 24,
+		15, 16, 17, 18, 19,
+		10, 11, 12, 13, 14,
+		 5,  6,  7,  8,  9,
+		 0,  1,  2,  3,  4
+	},
+	{	// SYMMETRY_DIAGONAL
+		 0,  5, 10, 15, 20,
+		 1,  6, 11, 16, 21,
+		 2,  7, 12, 17, 22,
+		 3,  8, 13, 18, 23,
+		 4,  9, 14, 19, 24
+	},
+	{	// SYMMETRY_ANTI_DIAGONAL
+		24, 19, 14,  9,  4,
+		23, 18, 13,  8,  3,
+		22, 17, 12,  7,  2,
+		21, 16, 11,  6,  1,
+		20, 15, 10,  5,  0
+	}
+};
+
+static const uint8_t inverses[NUM_SYMMETRIES] PROGMEM = {
+	SYMMETRY_IDENTITY, SYMMETRY_ROTATE_270, SYMMETRY_ROTATE_180,
+	SYMMETRY_ROTATE_90, SYMMETRY_MIRROR_X, SYMMETRY_MIRROR_Y,
+	SYMMETRY_DIAGONAL, SYMMETRY_ANTI_DIAGONAL
+};
+
+uint8_t transform_square(uint8_t symmetry, uint8_t square) {
+	return pgm_read_byte(&square_maps[symmetry][square]);
+}
+
+Bitboard transform_bitboard(uint8_t symmetry, Bitboard pieces) {
+	const uint8_t* map = square_maps[symmetry];
+	Bitboard result = 0;
+	uint8_t square = 0;
+	// walk the set bits only, skipping empty bytes of the board in one go
+	while (pieces) {
+		if (!(pieces & 0xFF)) {
+			pieces >>= 8;
+			square += 8;
+			continue;
+		}
+		if (pieces & 1) {
+			result |= (Bitboard)1 << pgm_read_byte(&map[square]);
+		}
+		pieces >>= 1;
+		square++;
+	}
+	return result;
+}
+
+uint8_t inverse_symmetry(uint8_t symmetry) {
+	return pgm_read_byte(&inverses[symmetry]);
+}
+
+uint8_t canonicalise_position(Bitboard* p1_pieces, Bitboard* p2_pieces) {
+	Bitboard best_p1 = *p1_pieces;
+	Bitboard best_p2 = *p2_pieces;
+	uint8_t best_symmetry = SYMMETRY_IDENTITY;
+	for (uint8_t symmetry = 1; symmetry < NUM_SYMMETRIES; symmetry++) {
+		Bitboard p1 = transform_bitboard(symmetry, *p1_pieces);
+		if (p1 > best_p1) {
+			continue;
+		}
+		// player 2's pieces only need transforming when player 1's don't
+		// already decide the order
+		Bitboard p2 = transform_bitboard(symmetry, *p2_pieces);
+		if (p1 < best_p1 || p2 < best_p2) {
+			best_p1 = p1;
+			best_p2 = p2;
+			best_symmetry = symmetry;
+		}
+	}
+	*p1_pieces = best_p1;
+	*p2_pieces = best_p2;
+	return best_symmetry;
+}
@@ -0,0 +1,47 @@
+/*
+ * symmetry.h
+ *
+ * The 8 symmetries of the Teeko board (rotations and reflections of the
+ * 5x5 square). Teeko's rules and winning patterns look the same under all
+ * of them, so positions which are symmetric copies of each other have the
+ * same value. Mapping a position to the canonical member of its symmetry
+ * class lets tables keyed on positions store each class only once.
+ */
+
+
+#ifndef SYMMETRY_H_
+#define SYMMETRY_H_
+
+#include <stdint.h>
+#include "teeko.h"
+
+#define NUM_SYMMETRIES 8
+
+// Symmetries, given as where they send square (x,y). N is WIDTH-1.
+#define SYMMETRY_IDENTITY		0	// (x, y)
+#define SYMMETRY_ROTATE_90		1	// (N-y, x)
+#define SYMMETRY_ROTATE_180		2	// (N-x, N-y)
+#define SYMMETRY_ROTATE_270		3	// (y, N-x)
+#define SYMMETRY_MIRROR_X		4	// (N-x, y)
+#define SYMMETRY_MIRROR_Y		5	// (x, N-y)
+#define SYMMETRY_DIAGONAL		6	// (y, x)
+#define SYMMETRY_ANTI_DIAGONAL	7	// (N-y, N-x)
+
+// returns the square index that 'square' is sent to by 'symmetry'
+uint8_t transform_square(uint8_t symmetry, uint8_t square);
+
+// returns the bitboard 'pieces' with 'symmetry' applied to every square
+Bitboard transform_bitboard(uint8_t symmetry, Bitboard pieces);
+
+// returns the symmetry which undoes 'symmetry'
+uint8_t inverse_symmetry(uint8_t symmetry);
+
+// Replaces the position (*p1_pieces, *p2_pieces) with the canonical member
+// of its symmetry class: the transformed position with the smallest
+// *p1_pieces, ties broken by the smallest *p2_pieces. Returns the symmetry
+// which was applied; its inverse maps squares of the canonical position
+// back to the original.
+uint8_t canonicalise_position(Bitboard* p1_pieces, Bitboard* p2_pieces);
+
+
+#endif /* SYMMETRY_H_ */
@@ -0,0 +1,218 @@
+/*
+ * teeko.c
+ *
+ * The rules of Teeko on bitboards: winning patterns, move generation and
+ * Zobrist keys. Nothing here touches the display or the game in progress,
+ * so it can be shared by the game, the AI search and the host-side tools.
+ */
+
+#include "teeko.h"
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+// Every winning pattern in Teeko, as the bitboard of the four squares that
+// make it up: four in a row horizontally, vertically or diagonally, or four
+// pieces forming a 2x2 square. The table lives in flash and is read with
+// pgm_read_dword.
+static const Bitboard win_masks[NUM_WIN_MASKS] PROGMEM = {
+	// horizontal rows of four
+	0x000000FUL, 0x000001EUL, 0x00001E0UL, 0x00003C0UL,
+	0x0003C00UL, 0x0007800UL, 0x0078000UL, 0x00F0000UL,
+	0x0F00000UL, 0x1E00000UL,
+	// vertical columns of four
+	0x0008421UL, 0x0108420UL, 0x0010842UL, 0x0210840UL,
+	0x0021084UL, 0x0421080UL, 0x0042108UL, 0x0842100UL,
+	0x0084210UL, 0x1084200UL,
+	// diagonals running up and to the right
+	0x0041041UL, 0x0082082UL, 0x0820820UL, 0x1041040UL,
+	// diagonals running up and to the left
+	0x0008888UL, 0x0011110UL, 0x0111100UL, 0x0222200UL,
+	// 2x2 squares
+	0x0000063UL, 0x00000C6UL, 0x000018CUL, 0x0000318UL,
+	0x0000C60UL, 0x00018C0UL, 0x0003180UL, 0x0006300UL,
+	0x0018C00UL, 0x0031800UL, 0x0063000UL, 0x00C6000UL,
+	0x0318000UL, 0x0630000UL, 0x0C60000UL, 0x18C0000UL
+};
+
+// Random keys for Zobrist hashing. The hash of a position is the XOR of the
+// key for each (player, square) holding a piece, plus ZOBRIST_SIDE_KEY when
+// PLAYER_2 is to move. Playing a move only changes a few keys, so the hash
+// can be updated rather than recomputed. (The values were drawn once from
+// a seeded random number generator.)
+static const uint32_t zobrist_keys[2][NUM_SQUARES] PROGMEM = {
+	{	// PLAYER_1
+		0x239FC724UL, 0xE4482EFFUL, 0x7C954258UL, 0x743F03FDUL, 0x3A8602EBUL,
+		0xA27047A5UL, 0x8BF214F9UL, 0x7024644BUL, 0x726C825AUL, 0xDD16F8A1UL,
+		0xF931A9AEUL, 0xFC32DBABUL, 0x41A9F9C8UL, 0xFDB0A6C3UL, 0xE0CE0337UL,
+		0x36E365E7UL, 0x30C1DF6DUL, 0x8266E97DUL, 0xC17FE292UL, 0x3E7A3D35UL,
+		0x455C184CUL, 0xDBCA826CUL, 0x9AF4939FUL, 0x88A6BB1FUL, 0x660D804AUL
+	},
+	{	// PLAYER_2
+		0xF0F59275UL, 0x7F03BC6BUL, 0x20584216UL, 0x9ED422D7UL, 0xA86B986BUL,
+		0x7EF944E5UL, 0x45FD4A5AUL, 0xC8AA6093UL, 0x3E39C607UL, 0x391F4039UL,
+		0x9264CC15UL, 0x08270103UL, 0x4CFD4C6CUL, 0xA6216211UL, 0x68ADE2EFUL,
+		0x3344C45FUL, 0xC3CE94B2UL, 0xA7EC283AUL, 0xCBD24FAFUL, 0xEB13B713UL,
+		0x89DAA41EUL, 0x3C678D27UL, 0xFACD2308UL, 0x2EAD4B9DUL, 0x9748C5C8UL
+	}
+};
+
+// For each square, the bitboard of the (up to 8) squares next to it
+// horizontally, vertically or diagonally. These are the squares a piece on
+// that square may move to in the movement phase, if they are empty.
+static const Bitboard neighbour_masks[NUM_SQUARES] PROGMEM = {
+	0x0000062UL, 0x00000E5UL, 0x00001CAUL, 0x0000394UL, 0x0000308UL,
+	0x0000C43UL, 0x0001CA7UL, 0x000394EUL, 0x000729CUL, 0x0006118UL,
+	0x0018860UL, 0x00394E0UL, 0x00729C0UL, 0x00E5380UL, 0x00C2300UL,
+	0x0310C00UL, 0x0729C00UL, 0x0E53800UL, 0x1CA7000UL, 0x1846000UL,
+	0x0218000UL, 0x0538000UL, 0x0A70000UL, 0x14E0000UL, 0x08C0000UL
+};
+
+// Change in square index for each of the 8 directions a slide can take, in
+// the order used by the move encoding (see teeko.h), and the reverse lookup
+// from (to - from + WIDTH + 1) to direction
+static const int8_t direction_offsets[8] PROGMEM = {
+	-WIDTH - 1, -WIDTH, -WIDTH + 1, -1, 1, WIDTH - 1, WIDTH, WIDTH + 1
+};
+static const uint8_t offset_directions[2 * WIDTH + 3] PROGMEM = {
+	0, 1, 2, NO_SQUARE, NO_SQUARE, 3, NO_SQUARE, 4, NO_SQUARE, NO_SQUARE,
+	5, 6, 7
+};
+
+// For each square, the indices into win_masks of the patterns which pass
+// through that square. The patterns for square s are entries
+// square_win_offsets[s] up to (but not including) square_win_offsets[s+1]
+// of square_win_indices.
+static const uint8_t square_win_offsets[NUM_SQUARES + 1] PROGMEM = {
+	0, 4, 10, 15, 21, 25, 31, 41, 51,
+	61, 67, 72, 82, 94, 104, 109, 115, 125,
+	135, 145, 151, 155, 161, 166, 172, 176
+};
+
+static const uint8_t square_win_indices[] PROGMEM = {
+	0, 10, 20, 28,							// square 0
+	0, 1, 12, 21, 28, 29,					// square 1
+	0, 1, 14, 29, 30,						// square 2
+	0, 1, 16, 24, 30, 31,					// square 3
+	1, 18, 25, 31,							// square 4
+	2, 10, 11, 22, 28, 32,					// square 5
+	2, 3, 12, 13, 20, 23, 28, 29, 32, 33,	// square 6
+	2, 3, 14, 15, 21, 24, 29, 30, 33, 34,	// square 7
+	2, 3, 16, 17, 25, 26, 30, 31, 34, 35,	// square 8
+	3, 18, 19, 27, 31, 35,					// square 9
+	4, 10, 11, 32, 36,						// square 10
+	4, 5, 12, 13, 22, 24, 32, 33, 36, 37,	// square 11
+	4, 5, 14, 15, 20, 23, 25, 26, 33, 34, 37, 38,	// square 12
+	4, 5, 16, 17, 21, 27, 34, 35, 38, 39,	// square 13
+	5, 18, 19, 35, 39,						// square 14
+	6, 10, 11, 24, 36, 40,					// square 15
+	6, 7, 12, 13, 25, 26, 36, 37, 40, 41,	// square 16
+	6, 7, 14, 15, 22, 27, 37, 38, 41, 42,	// square 17
+	6, 7, 16, 17, 20, 23, 38, 39, 42, 43,	// square 18
+	7, 18, 19, 21, 39, 43,					// square 19
+	8, 11, 26, 40,							// square 20
+	8, 9, 13, 27, 40, 41,					// square 21
+	8, 9, 15, 41, 42,						// square 22
+	8, 9, 17, 22, 42, 43,					// square 23
+	9, 19, 23, 43							// square 24
+};
+
+Bitboard get_win_mask(uint8_t index) {
+	return pgm_read_dword(&win_masks[index]);
+}
+
+uint32_t move_hash_change(uint8_t player, uint8_t from, uint8_t to) {
+	const uint32_t* keys = zobrist_keys[player - PLAYER_1];
+	uint32_t change = ZOBRIST_SIDE_KEY ^ pgm_read_dword(&keys[to]);
+	if (from != NO_SQUARE) {
+		change ^= pgm_read_dword(&keys[from]);
+	}
+	return change;
+}
+
+uint8_t pieces_have_won(Bitboard pieces) {
+	for (uint8_t i = 0; i < NUM_WIN_MASKS; i++) {
+		Bitboard mask = pgm_read_dword(&win_masks[i]);
+		if ((pieces & mask) == mask) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+uint8_t pieces_win_through(Bitboard pieces, uint8_t square) {
+	uint8_t end = pgm_read_byte(&square_win_offsets[square + 1]);
+	for (uint8_t i = pgm_read_byte(&square_win_offsets[square]); i < end; i++) {
+		Bitboard mask = pgm_read_dword(&win_masks[
+				pgm_read_byte(&square_win_indices[i])]);
+		if ((pieces & mask) == mask) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+Bitboard get_neighbours(uint8_t square) {
+	return pgm_read_dword(&neighbour_masks[square]);
+}
+
+uint8_t move_from(MoveCode move) {
+	if (move >= MOVE_DROP_BASE) {
+		return NO_SQUARE;
+	}
+	return move >> 3;
+}
+
+uint8_t move_to(MoveCode move) {
+	if (move >= MOVE_DROP_BASE) {
+		return move - MOVE_DROP_BASE;
+	}
+	return (move >> 3) + (int8_t)pgm_read_byte(&direction_offsets[move & 7]);
+}
+
+MoveCode encode_move(uint8_t from, uint8_t to) {
+	if (from == NO_SQUARE) {
+		return DROP_MOVE(to);
+	}
+	uint8_t direction = pgm_read_byte(&offset_directions[to - from + WIDTH + 1]);
+	return SLIDE_MOVE(from, direction);
+}
+
+uint8_t generate_moves(Bitboard own, Bitboard occupied, uint8_t placed,
+		MoveCode* moves) {
+	uint8_t num_moves = 0;
+	Bitboard targets;
+	if (placed < 2 * PIECES_PER_PLAYER) {
+		// every empty square is a drop
+		targets = ~occupied & BOARD_MASK;
+		while (targets) {
+			uint8_t to = __builtin_ctzl(targets);
+			targets &= targets - 1;
+			moves[num_moves++] = DROP_MOVE(to);
+		}
+		return num_moves;
+	}
+	// each piece can slide to any empty neighbour
+	while (own) {
+		uint8_t from = __builtin_ctzl(own);
+		own &= own - 1;
+		targets = pgm_read_dword(&neighbour_masks[from]) & ~occupied;
+		while (targets) {
+			uint8_t to = __builtin_ctzl(targets);
+			targets &= targets - 1;
+			moves[num_moves++] = encode_move(from, to);
+		}
+	}
+	return num_moves;
+}
+
+uint8_t is_legal_move(Bitboard own, Bitboard occupied, uint8_t placed,
+		uint8_t from, uint8_t to) {
+	if (to >= NUM_SQUARES || (occupied & ((Bitboard)1 << to))) {
+		return 0;
+	}
+	if (placed < 2 * PIECES_PER_PLAYER) {
+		return from == NO_SQUARE;
+	}
+	return from < NUM_SQUARES && (own & ((Bitboard)1 << from)) &&
+			(pgm_read_dword(&neighbour_masks[from]) & ((Bitboard)1 << to));
+}
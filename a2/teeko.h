@@ -0,0 +1,102 @@
+/*
+ * teeko.h
+ *
+ * The rules of Teeko on bitboards, independent of the game being played
+ * on the LED matrix. These are shared by game.c, the AI search and the
+ * host-side tools.
+ */
+
+
+#ifndef TEEKO_H_
+#define TEEKO_H_
+
+#include <stdint.h>
+#include "display.h"
+
+// the board is stored as bitboards, one bit per square. Square (x,y) is
+// bit number (y * WIDTH + x), so only the low 25 bits of a Bitboard are used
+typedef uint32_t Bitboard;
+
+#define SQUARE_INDEX(x, y)	((uint8_t)((y) * WIDTH + (x)))
+#define SQUARE_BIT(x, y)	((Bitboard)1 << SQUARE_INDEX(x, y))
+#define NUM_SQUARES			(WIDTH * HEIGHT)
+#define BOARD_MASK			(((Bitboard)1 << NUM_SQUARES) - 1)
+#define NO_SQUARE			0xFF
+
+// returns the number of pieces in 'pieces'. This loops once per piece,
+// which for the few pieces on a Teeko board beats a full population count.
+static inline uint8_t count_pieces(Bitboard pieces) {
+	uint8_t count = 0;
+	while (pieces) {
+		pieces &= pieces - 1;
+		count++;
+	}
+	return count;
+}
+
+// number of winning patterns (see get_win_mask)
+#define NUM_WIN_MASKS		44
+
+// Zobrist key XORed into a position's hash when PLAYER_2 is to move
+#define ZOBRIST_SIDE_KEY	0x5F15D93AUL
+
+// each player has four pieces to drop before the movement phase starts
+#define PIECES_PER_PLAYER	4
+
+// A move is encoded in one byte. A slide in the movement phase is the square
+// moved from times 8 plus the direction moved in (0 to 7: down-left, down,
+// down-right, left, right, up-left, up, up-right). A drop is MOVE_DROP_BASE
+// plus the square dropped on.
+typedef uint8_t MoveCode;
+
+#define MOVE_DROP_BASE			200
+#define DROP_MOVE(to)			((MoveCode)(MOVE_DROP_BASE + (to)))
+#define SLIDE_MOVE(from, dir)	((MoveCode)(((from) << 3) | (dir)))
+#define NO_MOVE					0xFF
+
+// the most moves a position can have: 25 empty squares in the drop phase,
+// or 4 pieces with up to 8 neighbours each in the movement phase
+#define MAX_MOVES				32
+
+// returns winning pattern number 'index' (0 to NUM_WIN_MASKS-1) as a bitboard
+Bitboard get_win_mask(uint8_t index);
+
+// returns 1 if the bitboard 'pieces' contains one of the Teeko winning
+// patterns (four in a row in any direction, or a 2x2 square), 0 otherwise
+uint8_t pieces_have_won(Bitboard pieces);
+
+// as for pieces_have_won, but only tests the winning patterns which pass
+// through 'square' (a square index). This is all that needs checking after
+// a piece arrives on that square.
+uint8_t pieces_win_through(Bitboard pieces, uint8_t square);
+
+// returns the bitboard of the squares next to 'square' (a square index)
+Bitboard get_neighbours(uint8_t square);
+
+// decode a move: the square moved from (NO_SQUARE for a drop) and the
+// square moved to
+uint8_t move_from(MoveCode move);
+uint8_t move_to(MoveCode move);
+
+// encode the move from 'from' (NO_SQUARE for a drop) to 'to'. A slide must
+// be between neighbouring squares.
+MoveCode encode_move(uint8_t from, uint8_t to);
+
+// fills 'moves' (which must have room for MAX_MOVES) with every legal move
+// for the player who owns 'own', and returns how many there are. 'occupied'
+// is every piece on the board and 'placed' the number dropped so far.
+uint8_t generate_moves(Bitboard own, Bitboard occupied, uint8_t placed,
+		MoveCode* moves);
+
+// returns 1 if moving from 'from' (NO_SQUARE for a drop) to 'to' is legal
+// for the player who owns 'own', 0 otherwise
+uint8_t is_legal_move(Bitboard own, Bitboard occupied, uint8_t placed,
+		uint8_t from, uint8_t to);
+
+// returns the value to XOR into a position's Zobrist hash when 'player'
+// moves a piece from 'from' to 'to' (from is NO_SQUARE for a drop). This
+// includes the change of player to move.
+uint32_t move_hash_change(uint8_t player, uint8_t from, uint8_t to);
+
+
+#endif /* TEEKO_H_ */
@@ -5,57 +5,130 @@
  */
 
 #include "terminalio.h"
-#include <stdio.h>
 #include <stdint.h>
 #include <avr/pgmspace.h>
+#include "serialio.h"
 
+/*
+ * Escape sequences are written straight into the serial output buffer
+ * rather than through printf_P, which would pull in vfprintf and parse a
+ * format string for every cursor move. Each sequence is written as one
+ * block.
+ */
+
+// The AVR has no divide instruction, so the digits are found by repeated
+// subtraction. At most 2 + 9 + 9 subtractions are needed.
+uint16_t terminal_bcd(uint8_t n) {
+	uint16_t bcd = 0;
+	while(n >= 100) {
+		n -= 100;
+		bcd += 0x100;
+	}
+	while(n >= 10) {
+		n -= 10;
+		bcd += 0x10;
+	}
+	return bcd | n;
+}
+
+static const uint32_t powers_of_ten[] PROGMEM = {
+	1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10
+};
+
+#define NUM_POWERS (sizeof(powers_of_ten) / sizeof(powers_of_ten[0]))
+
+void write_terminal_decimal(uint32_t n, uint8_t places) {
+	// the same way, a power of ten at a time, at most 9 times each. The
+	// digit before the point and any after it are written even if zero.
+	char digits[11];
+	uint8_t length = 0;
+	for(uint8_t i = 0; i < NUM_POWERS; i++) {
+		uint32_t power = pgm_read_dword(&powers_of_ten[i]);
+		uint8_t place = NUM_POWERS - i;
+		char digit = '0';
+		while(n >= power) {
+			n -= power;
+			digit++;
+		}
+		if(length || digit != '0' || place <= places) {
+			digits[length++] = digit;
+		}
+		if(place == places) {
+			digits[length++] = '.';
+		}
+	}
+	digits[length++] = '0' + n;
+	serial_write(digits, length, SERIAL_WRITE_WAIT);
+}
+
+void write_terminal_number(uint32_t n) {
+	write_terminal_decimal(n, 0);
+}
+
+// writes a BCD number without leading zeros to 'text', returning the
+// number of characters written
+static uint8_t format_bcd(char* text, uint16_t bcd) {
+	uint8_t length = 0;
+	if(bcd >= 0x100) {
+		text[length++] = '0' + (bcd >> 8);
+	}
+	if(bcd >= 0x10) {
+		text[length++] = '0' + ((bcd >> 4) & 0x0F);
+	}
+	text[length++] = '0' + (bcd & 0x0F);
+	return length;
+}
 
-void move_terminal_cursor(int x, int y) {
-    printf_P(PSTR("\x1b[%d;%dH"), y, x);
+void terminal_escape(uint16_t first, uint16_t second, char command) {
+	// the sequence is built up here and written in one go (the longest
+	// is ESC [ 255 ; 255 command)
+	char sequence[10];
+	uint8_t length = 0;
+	sequence[length++] = '\x1b';
+	sequence[length++] = '[';
+	length += format_bcd(sequence + length, first);
+	if(second != TERMINAL_NO_NUMBER) {
+		sequence[length++] = ';';
+		length += format_bcd(sequence + length, second);
+	}
+	sequence[length++] = command;
+	serial_write(sequence, length, SERIAL_WRITE_WAIT);
 }
 
 void normal_display_mode(void) {
-	printf_P(PSTR("\x1b[0m"));
+	serial_write_P(PSTR("\x1b[0m"), SERIAL_WRITE_WAIT);
 }
 
 void reverse_video(void) {
-	printf_P(PSTR("\x1b[7m"));
+	serial_write_P(PSTR("\x1b[7m"), SERIAL_WRITE_WAIT);
 }
 
 void clear_terminal(void) {
-	printf_P(PSTR("\x1b[2J"));
+	serial_write_P(PSTR("\x1b[2J"), SERIAL_WRITE_WAIT);
 }
 
 void clear_to_end_of_line(void) {
-	printf_P(PSTR("\x1b[K"));
-}
-
-void set_display_attribute(DisplayParameter parameter) {
-	printf_P(PSTR("\x1b[%dm"), parameter);
+	serial_write_P(PSTR("\x1b[K"), SERIAL_WRITE_WAIT);
 }
 
 void hide_cursor() {
-	printf_P(PSTR("\x1b[?25l"));
+	serial_write_P(PSTR("\x1b[?25l"), SERIAL_WRITE_WAIT);
 }
 
 void show_cursor() {
-	printf_P(PSTR("\x1b[?25h"));
+	serial_write_P(PSTR("\x1b[?25h"), SERIAL_WRITE_WAIT);
 }
 
 void enable_scrolling_for_whole_display(void) {
-	printf_P(PSTR("\x1b[r"));
-}
-
-void set_scroll_region(int8_t y1, int8_t y2) {
-	printf_P(PSTR("\x1b[%d;%dr"), y1, y2);
+	serial_write_P(PSTR("\x1b[r"), SERIAL_WRITE_WAIT);
 }
 
 void scroll_down(void) {
-	printf_P(PSTR("\x1bM"));	// ESC-M
+	serial_write_P(PSTR("\x1bM"), SERIAL_WRITE_WAIT);	// ESC-M
 }
 
 void scroll_up(void) {
-	printf_P(PSTR("\x1b\x44"));	// ESC-D
+	serial_write_P(PSTR("\x1b\x44"), SERIAL_WRITE_WAIT);	// ESC-D
 }
 
 void draw_horizontal_line(int8_t y, int8_t start_x, int8_t end_x) {
@@ -63,10 +136,7 @@ void draw_horizontal_line(int8_t y, int8_t start_x, int8_t end_x) {
 	move_terminal_cursor(start_x, y);
 	reverse_video();
 	for(i=start_x; i <= end_x; i++) {
-		printf(" ");	/* No need to use printf_P - printing 
-						 * a single character gets optimised
-						 * to a putchar call 
-						 */
+		serial_put_char(' ');
 	}
 	normal_display_mode();
 }
@@ -76,10 +146,10 @@ void draw_vertical_line(int8_t x, int8_t start_y, int8_t end_y) {
 	move_terminal_cursor(x, start_y);
 	reverse_video();
 	for(i=start_y; i < end_y; i++) {
-		printf(" ");
+		serial_put_char(' ');
 		/* Move down one and back to the left one */
-		printf_P(PSTR("\x1b[B\x1b[D"));
+		serial_write_P(PSTR("\x1b[B\x1b[D"), SERIAL_WRITE_WAIT);
 	}
-	printf(" ");
+	serial_put_char(' ');
 	normal_display_mode();
 }
@@ -55,19 +55,62 @@ typedef enum {
 	BG_WHITE = 47
 } DisplayParameter;
 
-void move_terminal_cursor(int x, int y);
+/*
+ * Escape sequences with numbers are all output by terminal_escape(), which
+ * takes the numbers in BCD (one decimal digit per 4 bits). The functions
+ * below convert their arguments with terminal_number(), which does the
+ * conversion at compile time when the argument is a constant, so e.g.
+ * move_terminal_cursor(10, 14) costs no arithmetic at all when it runs.
+ */
+#define TERMINAL_BCD(n) ((((n) / 100) << 8) | (((n) / 10 % 10) << 4) | ((n) % 10))
+#define TERMINAL_NO_NUMBER 0xFFFF
+
+// returns n (0 to 255) in BCD
+uint16_t terminal_bcd(uint8_t n);
+
+// writes n in decimal, finding the digits the same way as terminal_bcd()
+void write_terminal_number(uint32_t n);
+
+// writes n in decimal with a point before its last 'places' digits (1 to
+// 9), so 'n' is in units of 10^-places. write_terminal_decimal(53, 1)
+// writes "5.3".
+void write_terminal_decimal(uint32_t n, uint8_t places);
+
+// outputs ESC [ first ; second command, leaving out "; second" if second
+// is TERMINAL_NO_NUMBER
+void terminal_escape(uint16_t first, uint16_t second, char command);
+
+static inline __attribute__((always_inline)) uint16_t terminal_number(uint8_t n) {
+	return __builtin_constant_p(n) ? TERMINAL_BCD(n) : terminal_bcd(n);
+}
+
+// x and y can be 1 to 255 (the most an escape sequence here can hold)
+static inline __attribute__((always_inline)) void move_terminal_cursor(uint8_t x, uint8_t y) {
+	terminal_escape(terminal_number(y), terminal_number(x), 'H');
+}
+
+// moves the cursor 'columns' columns right, stopping at the edge of the screen
+static inline __attribute__((always_inline)) void move_terminal_cursor_right(uint8_t columns) {
+	terminal_escape(terminal_number(columns), TERMINAL_NO_NUMBER, 'C');
+}
+
+static inline __attribute__((always_inline)) void set_display_attribute(DisplayParameter parameter) {
+	terminal_escape(terminal_number(parameter), TERMINAL_NO_NUMBER, 'm');
+}
+
 void normal_display_mode(void);
 void reverse_video(void);
 void clear_terminal(void);
 void clear_to_end_of_line(void);
-void set_display_attribute(DisplayParameter parameter);
 void hide_cursor(void);
 void show_cursor(void);
 
 // Enable scrolling for either the full screen or a particular region (rows)
 // For set_scroll_region y1 < y2 and the region includes rows y1 and y2.
 void enable_scrolling_for_whole_display(void);
-void set_scroll_region(int8_t y1, int8_t y2);
+static inline __attribute__((always_inline)) void set_scroll_region(uint8_t y1, uint8_t y2) {
+	terminal_escape(terminal_number(y1), terminal_number(y2), 'r');
+}
 
 // If the cursor is in the first (top) row of the scroll region then scroll
 // the scroll region down by one row. The bottom row of the scroll region will be lost.
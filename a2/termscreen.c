@@ -0,0 +1,154 @@
+/*
+ * termscreen.c
+ *
+ * Diff-based drawing of a region of the serial terminal. At 250000 baud
+ * each byte takes 40 us, so about 25 bytes go out per millisecond (and
+ * only 2 at the 19200 baud fallback). A cursor position plus a colour
+ * change costs up to a dozen bytes, half a millisecond at 250000 baud, so
+ * the flush works out the cheapest way to reach each changed cell from
+ * where the terminal cursor was left and keeps the colour across cells
+ * until it has to change.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#include "termscreen.h"
+#include "serialio.h"
+
+#define DIRTY_BYTES ((TERM_SCREEN_COLS + 7) / 8)
+
+// colour of the plain ASCII cells (the terminal's normal attributes)
+#define NORMAL_COLOUR 0xFF
+// cursor row meaning the terminal cursor could be anywhere
+#define UNKNOWN_ROW 0xFF
+
+// Most bytes one cell can take: a cursor position, a colour change and the
+// character, plus the reset to normal colours at the end of the flush.
+#define CELL_RESERVE 20
+
+static const char glyph_chars[] PROGMEM = "O+@";
+
+// the grid as the terminal shows it once every dirty cell has been sent
+static uint8_t cells[TERM_SCREEN_ROWS][TERM_SCREEN_COLS];
+// bit (col % 8) of dirty[row][col / 8] is set if the cell has changed
+static uint8_t dirty[TERM_SCREEN_ROWS][DIRTY_BYTES];
+
+void init_term_screen(void) {
+	memset(cells, ' ', sizeof(cells));
+	memset(dirty, 0, sizeof(dirty));
+}
+
+void term_screen_redraw(void) {
+	memset(dirty, 0xFF, sizeof(dirty));
+}
+
+void term_screen_put(uint8_t row, uint8_t col, uint8_t cell) {
+	if (row >= TERM_SCREEN_ROWS || col >= TERM_SCREEN_COLS ||
+			cells[row][col] == cell) {
+		return;
+	}
+	cells[row][col] = cell;
+	dirty[row][col / 8] |= 1 << (col % 8);
+}
+
+void term_screen_print_P(uint8_t row, uint8_t col, uint8_t width,
+		const char* text) {
+	char c;
+	while (width && (c = pgm_read_byte(text)) != '\0') {
+		term_screen_put(row, col++, c);
+		text++;
+		width--;
+	}
+	while (width--) {
+		term_screen_put(row, col++, ' ');
+	}
+}
+
+static uint8_t cell_colour(uint8_t cell) {
+	return (cell & 0x80) ? (cell >> 4) & 0x07 : NORMAL_COLOUR;
+}
+
+static char cell_char(uint8_t cell) {
+	return (cell & 0x80) ? pgm_read_byte(&glyph_chars[cell & 0x0F]) : cell;
+}
+
+static uint8_t number_length(uint8_t n) {
+	return (n >= 100) ? 3 : (n >= 10) ? 2 : 1;
+}
+
+// 1 if cells [from, to) of 'row' are all shown in 'colour', so the cursor
+// can be moved over them by printing them again
+static uint8_t run_has_colour(uint8_t row, uint8_t from, uint8_t to,
+		uint8_t colour) {
+	for (uint8_t col = from; col < to; col++) {
+		if (cell_colour(cells[row][col]) != colour) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+uint8_t term_screen_flush(void) {
+	// anything may have been printed since the last flush, so the cursor
+	// position is unknown, but all other output uses normal colours
+	uint8_t colour = NORMAL_COLOUR;
+	uint8_t cursor_row = UNKNOWN_ROW, cursor_col = 0;
+	uint8_t finished = 1;
+
+	for (uint8_t row = 0; row < TERM_SCREEN_ROWS && finished; row++) {
+		for (uint8_t col = 0; col < TERM_SCREEN_COLS; col++) {
+			if (!(dirty[row][col / 8] & (1 << (col % 8)))) {
+				if (!dirty[row][col / 8] && col % 8 == 0) {
+					col += 7;
+				}
+				continue;
+			}
+			if (serial_output_space() < CELL_RESERVE) {
+				finished = 0;
+				break;
+			}
+
+			// get the cursor to the cell the cheapest way: print the cells
+			// in between again, step it right, or position it
+			uint8_t y = TERM_SCREEN_Y + row, x = TERM_SCREEN_X + col;
+			uint8_t position_cost = 4 + number_length(y) + number_length(x);
+			if (cursor_row != row || cursor_col > col) {
+				move_terminal_cursor(x, y);
+			} else if (cursor_col < col) {
+				uint8_t gap = col - cursor_col;
+				uint8_t forward_cost = 3 + number_length(gap);
+				if (gap <= forward_cost && gap <= position_cost &&
+						run_has_colour(row, cursor_col, col, colour)) {
+					while (cursor_col < col) {
+						serial_put_char(cell_char(cells[row][cursor_col++]));
+					}
+				} else if (forward_cost <= position_cost) {
+					move_terminal_cursor_right(gap);
+				} else {
+					move_terminal_cursor(x, y);
+				}
+			}
+
+			uint8_t cell = cells[row][col];
+			if (cell_colour(cell) != colour) {
+				colour = cell_colour(cell);
+				if (colour == NORMAL_COLOUR) {
+					normal_display_mode();
+				} else {
+					set_display_attribute(FG_BLACK + colour);
+				}
+			}
+			serial_put_char(cell_char(cell));
+			dirty[row][col / 8] &= ~(1 << (col % 8));
+			cursor_row = row;
+			cursor_col = col + 1;
+		}
+	}
+
+	if (colour != NORMAL_COLOUR) {
+		normal_display_mode();
+	}
+	return finished;
+}
@@ -0,0 +1,59 @@
+/*
+ * termscreen.h
+ *
+ * A small region of the serial terminal kept as a grid of cells, so the
+ * game can redraw its board and status there every pass of the main loop
+ * while only the cells which actually changed are sent.
+ *
+ * The grid remembers what the terminal shows. Writing a cell with the
+ * value it already holds costs nothing; term_screen_flush() sends the
+ * changed cells, moving the cursor and changing colour only when it has
+ * to, and stops before it could fill the serial output buffer.
+ */
+
+
+#ifndef TERMSCREEN_H_
+#define TERMSCREEN_H_
+
+#include <stdint.h>
+#include "terminalio.h"
+
+// size of the grid, and the terminal column (x) and row (y) of its top
+// left cell
+#define TERM_SCREEN_ROWS 5
+#define TERM_SCREEN_COLS 28
+#define TERM_SCREEN_X 10
+#define TERM_SCREEN_Y 3
+
+// A cell is either a printable ASCII character, shown in the terminal's
+// normal colours, or one of the glyphs below in a foreground colour
+// (FG_BLACK to FG_WHITE), made with TERM_GLYPH().
+#define TERM_GLYPH_PIECE 0
+#define TERM_GLYPH_CURSOR 1
+#define TERM_GLYPH_SELECTED 2
+
+#define TERM_GLYPH(colour, glyph) \
+		(0x80 | (((colour) - FG_BLACK) << 4) | (glyph))
+
+// Forget what the grid held. Call this after the terminal is cleared; the
+// grid is then all spaces, matching the terminal.
+void init_term_screen(void);
+
+// Mark every cell as changed so the next flushes redraw the whole grid
+// (e.g. if the terminal was cleared or resized by its user).
+void term_screen_redraw(void);
+
+// Set the cell at (row, col) of the grid, with row 0 at the top.
+void term_screen_put(uint8_t row, uint8_t col, uint8_t cell);
+
+// Write the program memory string 'text' from (row, col), padding it with
+// spaces to 'width' cells.
+void term_screen_print_P(uint8_t row, uint8_t col, uint8_t width,
+		const char* text);
+
+// Send changed cells to the terminal for as long as the serial output
+// buffer has room, so this never waits for the UART. Returns 1 once the
+// terminal matches the grid, or 0 if changes remain for a later call.
+uint8_t term_screen_flush(void);
+
+#endif /* TERMSCREEN_H_ */
@@ -11,6 +11,8 @@
 #include "timer0.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include "animation.h"
+#include "ledmatrix.h"
 
 /* Our internal clock tick count - incremented every 
  * millisecond. Will overflow every ~49 days. */
@@ -75,4 +77,9 @@ uint32_t get_current_time(void) {
 ISR(TIMER0_COMPA_vect) {
 	/* Increment our clock tick count */
 	clockTicks++;
+	
+	/* Step any animation, then send the LED matrix frame if one is
+	 * due (so it includes the step) */
+	animation_tick();
+	ledmatrix_frame_tick();
 }
@@ -0,0 +1,64 @@
+/*
+ * ttable.c
+ *
+ * Bucketed transposition table. The low TT_BUCKET_BITS bits of a hash pick
+ * the bucket, and the top 16 bits are kept in the entry to tell apart the
+ * positions that share a bucket.
+ */
+
+#include "ttable.h"
+#include <stdint.h>
+#include <string.h>
+
+#define TT_NUM_BUCKETS	((uint16_t)1 << TT_BUCKET_BITS)
+#define TT_BUCKET_MASK	(TT_NUM_BUCKETS - 1)
+
+typedef struct {
+	TTEntry entries[TT_BUCKET_ENTRIES];
+} TTBucket;
+
+// TTEntry is 7 bytes
+#if (1L << TT_BUCKET_BITS) * TT_BUCKET_ENTRIES * 7 > TT_SRAM_BUDGET
+#error "Transposition table does not fit in TT_SRAM_BUDGET"
+#endif
+
+static TTBucket table[TT_NUM_BUCKETS];
+
+// an entry with depth 0 is unused (the search never stores depth 0)
+void tt_clear(void) {
+	memset(table, 0, sizeof(table));
+}
+
+TTEntry* tt_probe(uint32_t hash) {
+	TTBucket* bucket = &table[(uint16_t)hash & TT_BUCKET_MASK];
+	uint16_t check = hash >> 16;
+	for (uint8_t i = 0; i < TT_BUCKET_ENTRIES; i++) {
+		TTEntry* entry = &bucket->entries[i];
+		if (entry->depth != 0 && entry->check == check) {
+			return entry;
+		}
+	}
+	return 0;
+}
+
+void tt_store(uint32_t hash, uint8_t depth, int16_t score, uint8_t bound,
+		uint8_t best_move) {
+	TTBucket* bucket = &table[(uint16_t)hash & TT_BUCKET_MASK];
+	uint16_t check = hash >> 16;
+	TTEntry* replace = &bucket->entries[0];
+	for (uint8_t i = 0; i < TT_BUCKET_ENTRIES; i++) {
+		TTEntry* entry = &bucket->entries[i];
+		if (entry->depth != 0 && entry->check == check) {
+			replace = entry;
+			break;
+		}
+		if (entry->depth < replace->depth) {
+			replace = entry;
+		}
+	}
+	replace->check = check;
+	replace->score = score;
+	replace->best_move = best_move;
+	replace->depth = depth;
+	replace->bound = bound;
+}
@@ -0,0 +1,54 @@
+/*
+ * ttable.h
+ *
+ * Transposition table for the Teeko search. Results are stored against the
+ * Zobrist hash of the position they were found for, so that a position
+ * reached again (by another move order, or on a later turn) need not be
+ * searched a second time.
+ *
+ * The table is a fixed array of buckets, sized at compile time to fit in
+ * TT_SRAM_BUDGET bytes. Of the 2 KB of SRAM, the serial, SPI and button
+ * queues, the LED framebuffer, the terminal grid and the command line
+ * take about 1.1 KB, and a full depth search needs about 650 bytes of
+ * stack (AI_MAX_DEPTH frames, each with a MAX_MOVES move list). That
+ * leaves room for 256 bytes: 32 entries of 7 bytes, in 16 buckets of 2.
+ */
+
+
+#ifndef TTABLE_H_
+#define TTABLE_H_
+
+#include <stdint.h>
+
+#define TT_SRAM_BUDGET		256
+#define TT_BUCKET_BITS		4	// 16 buckets
+#define TT_BUCKET_ENTRIES	2
+
+// what a stored score says about the true score of the position
+#define TT_EXACT	0
+#define TT_LOWER	1	// the search failed high, the true score is >= score
+#define TT_UPPER	2	// the search failed low, the true score is <= score
+
+typedef struct {
+	uint16_t check;		// top 16 bits of the hash, to spot index clashes
+	int16_t score;
+	uint8_t best_move;	// best move found (a MoveCode)
+	uint8_t depth;		// depth in plies the position was searched to
+	uint8_t bound;		// TT_EXACT, TT_LOWER or TT_UPPER
+} TTEntry;
+
+// empty the table, e.g. at the start of a new game
+void tt_clear(void);
+
+// returns the entry stored for the position with this hash, or 0 (NULL)
+// if there is none
+TTEntry* tt_probe(uint32_t hash);
+
+// store a search result for the position with this hash. An existing entry
+// for the same position is overwritten, otherwise the shallowest entry in
+// its bucket is replaced.
+void tt_store(uint32_t hash, uint8_t depth, int16_t score, uint8_t bound,
+		uint8_t best_move);
+
+
+#endif /* TTABLE_H_ */
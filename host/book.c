@@ -0,0 +1,287 @@
+/*
+ * book.c
+ *
+ * teeko-book: builds the firmware's opening book from a solved database.
+ *
+ * usage: teeko-book [-p placed] database output-file
+ *
+ * The book holds one perfect move for each drop phase position the
+ * computer can face while it stays in book, whichever colour it plays,
+ * for positions with up to 'placed' pieces on the board (default
+ * BOOK_DEFAULT_PLACED). Positions are stored once per symmetry class.
+ * Where several moves are equally good, the one leaving the fewest
+ * distinct replies to cover is chosen, which keeps the book small.
+ *
+ * The output is a C header for a2/book.c; the encoding is described
+ * there.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "teeko.h"
+#include "symmetry.h"
+#include "teekodb.h"
+
+#define BOOK_DEFAULT_PLACED 6
+#define BOOK_BLOCK_SIZE 16
+// bits of each varint holding a square (enough for NUM_SQUARES)
+#define BOOK_SQUARE_BITS 5
+
+typedef struct {
+	uint32_t key;
+	uint8_t square;
+} BookEntry;
+
+static const TeekoDb* db;
+static uint8_t max_placed;
+static BookEntry* entries;
+static size_t num_entries, entries_capacity;
+static uint32_t level_base[2 * PIECES_PER_PLAYER + 1];
+
+// colex rank of a set of squares among the sets of the same size
+static uint32_t rank_set(Bitboard pieces) {
+	uint32_t rank = 0;
+	uint8_t count = 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if (pieces & ((Bitboard)1 << square)) {
+			rank += db_choose[square][++count];
+		}
+	}
+	return rank;
+}
+
+// must match book_key() in a2/book.c
+static uint32_t position_key(Bitboard p1, Bitboard p2) {
+	uint8_t placed = count_pieces(p1 | p2);
+	return level_base[placed] + rank_set(p1) * db_choose[NUM_SQUARES][placed / 2]
+			+ rank_set(p2);
+}
+
+static void add_entry(uint32_t key, uint8_t square) {
+	if (num_entries == entries_capacity) {
+		entries_capacity = entries_capacity ? 2 * entries_capacity : 1024;
+		entries = realloc(entries, entries_capacity * sizeof(BookEntry));
+		if (!entries) {
+			perror("realloc");
+			exit(1);
+		}
+	}
+	entries[num_entries].key = key;
+	entries[num_entries].square = square;
+	num_entries++;
+}
+
+static void drop_piece(Bitboard* p1, Bitboard* p2, uint8_t player,
+		uint8_t square) {
+	if (player == PLAYER_1) {
+		*p1 |= (Bitboard)1 << square;
+	} else {
+		*p2 |= (Bitboard)1 << square;
+	}
+}
+
+// returns the number of symmetry classes among the positions reachable
+// by one drop of 'player' from (p1, p2), or 0 if one of them wins
+static uint8_t count_replies(Bitboard p1, Bitboard p2, uint8_t player) {
+	Bitboard seen[NUM_SQUARES][2];
+	uint8_t num_seen = 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if ((p1 | p2) & ((Bitboard)1 << square)) {
+			continue;
+		}
+		Bitboard next_p1 = p1, next_p2 = p2;
+		drop_piece(&next_p1, &next_p2, player, square);
+		if (pieces_have_won(player == PLAYER_1 ? next_p1 : next_p2)) {
+			return 0;
+		}
+		canonicalise_position(&next_p1, &next_p2);
+		uint8_t i = 0;
+		while (i < num_seen && (seen[i][0] != next_p1 || seen[i][1] != next_p2)) {
+			i++;
+		}
+		if (i == num_seen) {
+			seen[num_seen][0] = next_p1;
+			seen[num_seen][1] = next_p2;
+			num_seen++;
+		}
+	}
+	return num_seen;
+}
+
+static void expand(Bitboard p1, Bitboard p2, uint8_t book_player);
+
+// the book player is to move in the canonical position (p1, p2)
+static void book_move(Bitboard p1, Bitboard p2, uint8_t player) {
+	uint8_t opponent = (player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	MoveCode moves[MAX_MOVES];
+	uint8_t num_moves = teekodb_best_moves(db, p1, p2, player, moves, NULL);
+	uint8_t best_square = NO_SQUARE, best_replies = 0xFF;
+	for (uint8_t i = 0; i < num_moves; i++) {
+		Bitboard next_p1 = p1, next_p2 = p2;
+		drop_piece(&next_p1, &next_p2, player, move_to(moves[i]));
+		uint8_t replies = 0;
+		if (!pieces_have_won(player == PLAYER_1 ? next_p1 : next_p2) &&
+				count_pieces(p1 | p2) + 1 < max_placed) {
+			replies = count_replies(next_p1, next_p2, opponent);
+		}
+		if (replies < best_replies) {
+			best_replies = replies;
+			best_square = move_to(moves[i]);
+		}
+	}
+	add_entry(position_key(p1, p2), best_square);
+	drop_piece(&p1, &p2, player, best_square);
+	if (!pieces_have_won(player == PLAYER_1 ? p1 : p2)) {
+		expand(p1, p2, player);
+	}
+}
+
+// the book player's opponent is to move from (p1, p2): follow every reply
+static void expand(Bitboard p1, Bitboard p2, uint8_t book_player) {
+	uint8_t opponent = (book_player == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	if (count_pieces(p1 | p2) + 1 > max_placed) {
+		return;
+	}
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if ((p1 | p2) & ((Bitboard)1 << square)) {
+			continue;
+		}
+		Bitboard next_p1 = p1, next_p2 = p2;
+		drop_piece(&next_p1, &next_p2, opponent, square);
+		if (pieces_have_won(opponent == PLAYER_1 ? next_p1 : next_p2)) {
+			continue;
+		}
+		canonicalise_position(&next_p1, &next_p2);
+		book_move(next_p1, next_p2, book_player);
+	}
+}
+
+static int compare_entries(const void* a, const void* b) {
+	uint32_t key_a = ((const BookEntry*)a)->key;
+	uint32_t key_b = ((const BookEntry*)b)->key;
+	return (key_a > key_b) - (key_a < key_b);
+}
+
+// appends 'value' to 'data' as a little-endian base 128 number
+static size_t put_varint(uint8_t* data, uint32_t value) {
+	size_t length = 0;
+	while (value >= 0x80) {
+		data[length++] = (value & 0x7F) | 0x80;
+		value >>= 7;
+	}
+	data[length++] = value;
+	return length;
+}
+
+// what to print before item 'i' of an array written 'per_line' a line
+static const char* separator(size_t i, size_t per_line) {
+	if (i == 0) {
+		return "\n\t";
+	}
+	return (i % per_line) ? ", " : ",\n\t";
+}
+
+static void usage(const char* program) {
+	fprintf(stderr, "usage: %s [-p placed] database output-file\n", program);
+	exit(1);
+}
+
+int main(int argc, char** argv) {
+	max_placed = BOOK_DEFAULT_PLACED;
+	int option;
+	while ((option = getopt(argc, argv, "p:")) != -1) {
+		if (option == 'p') {
+			max_placed = atoi(optarg);
+		} else {
+			usage(argv[0]);
+		}
+	}
+	if (argc - optind != 2 || max_placed >= 2 * PIECES_PER_PLAYER) {
+		usage(argv[0]);
+	}
+
+	TeekoDb* database = teekodb_open(argv[optind]);
+	if (!database) {
+		return 1;
+	}
+	db = database;
+	for (uint8_t placed = 1; placed <= 2 * PIECES_PER_PLAYER; placed++) {
+		uint8_t before = placed - 1;
+		level_base[placed] = level_base[before] +
+				db_choose[NUM_SQUARES][(before + 1) / 2] *
+				db_choose[NUM_SQUARES][before / 2];
+	}
+
+	// the computer as player 1 starts from the empty board, and as
+	// player 2 from each of player 1's first drops
+	book_move(0, 0, PLAYER_1);
+	expand(0, 0, PLAYER_2);
+
+	qsort(entries, num_entries, sizeof(BookEntry), compare_entries);
+	size_t unique = 0;
+	for (size_t i = 0; i < num_entries; i++) {
+		if (unique == 0 || entries[i].key != entries[unique - 1].key) {
+			entries[unique++] = entries[i];
+		}
+	}
+	num_entries = unique;
+
+	size_t num_blocks = (num_entries + BOOK_BLOCK_SIZE - 1) / BOOK_BLOCK_SIZE;
+	uint8_t* data = malloc(num_entries * 5);
+	uint32_t* block_offsets = malloc(num_blocks * sizeof(uint32_t));
+	size_t data_size = 0;
+	for (size_t i = 0; i < num_entries; i++) {
+		if (i % BOOK_BLOCK_SIZE == 0) {
+			block_offsets[i / BOOK_BLOCK_SIZE] = data_size;
+			data[data_size++] = entries[i].square;
+		} else {
+			uint32_t gap = entries[i].key - entries[i - 1].key - 1;
+			data_size += put_varint(data + data_size,
+					(gap << BOOK_SQUARE_BITS) | entries[i].square);
+		}
+	}
+
+	FILE* output = fopen(argv[optind + 1], "w");
+	if (!output) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+	fprintf(output, "/*\n * book_data.h\n *\n"
+			" * Opening book for book.c, generated by host/teeko-book -p %u.\n"
+			" * Do not edit.\n */\n\n", max_placed);
+	fprintf(output, "#define BOOK_MAX_PLACED %u\n", max_placed);
+	fprintf(output, "#define BOOK_BLOCK_SIZE %u\n", BOOK_BLOCK_SIZE);
+	fprintf(output, "#define BOOK_SQUARE_BITS %u\n", BOOK_SQUARE_BITS);
+	fprintf(output, "#define BOOK_NUM_BLOCKS %zu\n\n", num_blocks);
+	fprintf(output, "static const uint32_t book_level_base[BOOK_MAX_PLACED + 1] "
+			"PROGMEM = {");
+	for (uint8_t placed = 0; placed <= max_placed; placed++) {
+		fprintf(output, "%s%u", placed ? ", " : "", level_base[placed]);
+	}
+	fprintf(output, "};\n\n// key of the first position in each block\n");
+	fprintf(output, "static const uint32_t book_block_keys[BOOK_NUM_BLOCKS] "
+			"PROGMEM = {");
+	for (size_t i = 0; i < num_blocks; i++) {
+		fprintf(output, "%s%u", separator(i, 6), entries[i * BOOK_BLOCK_SIZE].key);
+	}
+	fprintf(output, "\n};\n\n");
+	fprintf(output, "static const uint16_t book_block_offsets[BOOK_NUM_BLOCKS] "
+			"PROGMEM = {");
+	for (size_t i = 0; i < num_blocks; i++) {
+		fprintf(output, "%s%u", separator(i, 10), block_offsets[i]);
+	}
+	fprintf(output, "\n};\n\n");
+	fprintf(output, "static const uint8_t book_data[%zu] PROGMEM = {", data_size);
+	for (size_t i = 0; i < data_size; i++) {
+		fprintf(output, "%s0x%02X", separator(i, 12), data[i]);
+	}
+	fprintf(output, "\n};\n");
+	fclose(output);
+
+	printf("%zu positions in %zu blocks, %zu bytes of flash\n", num_entries,
+			num_blocks, data_size + num_blocks * 6 + (max_placed + 1) * 4);
+	teekodb_close(database);
+	return 0;
+}
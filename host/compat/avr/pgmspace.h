@@ -0,0 +1,23 @@
+/*
+ * avr/pgmspace.h (host build)
+ *
+ * Lets the firmware's rule tables (teeko.c, symmetry.c) be compiled into
+ * the host tools unchanged. Flash and RAM are the same address space on
+ * the host, so PROGMEM data is just read directly.
+ */
+
+#ifndef HOST_PGMSPACE_H_
+#define HOST_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address)	(*(const uint8_t*)(address))
+#define pgm_read_word(address)	(*(const uint16_t*)(address))
+#define pgm_read_dword(address)	(*(const uint32_t*)(address))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#endif /* HOST_PGMSPACE_H_ */
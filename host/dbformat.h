@@ -0,0 +1,137 @@
+/*
+ * dbformat.h
+ *
+ * Layout of the solved Teeko position database and how positions are
+ * numbered within it. Shared by the solver (solve.c) and the query
+ * library (teekodb.c).
+ *
+ * Positions are grouped into layers by the number of pieces each player
+ * has and the player to move. Within a layer a position is numbered by
+ * the combinatorial (colex) rank of player 1's pieces among the 25
+ * squares, and of player 2's pieces among the squares player 1 leaves
+ * free:
+ *		index = rank(p1) * p2_sets + rank(p2 among ~p1)
+ * The solver works on every position. The file only stores positions
+ * whose player 1 pieces are the canonical member of their symmetry class
+ * (see symmetry.h), so rank(p1) is replaced by the number of that class.
+ * A class table per piece count maps rank(p1) to its class number.
+ *
+ * Each position is stored in one byte:
+ *		DB_DRAW (0)		neither player can force a win
+ *		DB_INVALID		the position can't arise (the player to move has
+ *						already won)
+ *		otherwise		the value less one is the number of plies to the
+ *						end of the game with perfect play. The player to
+ *						move wins if it is odd and loses if it is even.
+ *
+ * All file fields are little-endian.
+ */
+
+
+#ifndef DBFORMAT_H_
+#define DBFORMAT_H_
+
+#include <stdint.h>
+#include "teeko.h"
+
+#define DB_MAGIC		"TEEKODB1"
+#define DB_VERSION		1
+
+#define DB_DRAW			0
+#define DB_INVALID		0xFF
+#define DB_MAX_DISTANCE	253
+
+#define DB_VALUE(distance)	((uint8_t)((distance) + 1))
+#define DB_DISTANCE(value)	((value) - 1)
+#define DB_IS_WIN(value)	((value) != DB_DRAW && (value) != DB_INVALID && \
+							!((value) & 1))
+#define DB_IS_LOSS(value)	((value) != DB_INVALID && ((value) & 1))
+
+// one layer for each piece count in the drop phase (the player to move
+// follows from it), then the movement phase with each player to move
+#define DB_NUM_LAYERS		(2 * PIECES_PER_PLAYER + 2)
+#define DB_NO_LAYER			0xFF
+
+typedef struct {
+	uint8_t p1_count;
+	uint8_t p2_count;
+	uint8_t to_move;		// PLAYER_1 or PLAYER_2
+	uint8_t reserved;
+	uint32_t p2_sets;		// number of ways to place player 2's pieces
+	uint64_t offset;		// file offset of the layer's values
+} DbLayerHeader;
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t num_layers;
+	// for each piece count, the file offset of the uint16_t class table
+	// (DB_NO_CLASS for sets which aren't canonical) and the number of classes
+	uint64_t class_table_offsets[PIECES_PER_PLAYER + 1];
+	uint32_t class_counts[PIECES_PER_PLAYER + 1];
+	uint32_t reserved;
+	DbLayerHeader layers[DB_NUM_LAYERS];
+} DbHeader;
+
+#define DB_NO_CLASS		0xFFFF
+
+// fill in db_choose. Must be called before anything else here. Only the
+// first call does anything, and it is safe to call from several threads.
+void db_init_index(void);
+
+// n choose k, for n <= NUM_SQUARES and k <= PIECES_PER_PLAYER
+extern uint32_t db_choose[NUM_SQUARES + 1][PIECES_PER_PLAYER + 1];
+
+// the layer holding positions with these piece counts and player to move,
+// or DB_NO_LAYER if there is none
+uint8_t db_layer(uint8_t p1_count, uint8_t p2_count, uint8_t to_move);
+
+// piece counts and player to move of each layer
+void db_layer_shape(uint8_t layer, uint8_t* p1_count, uint8_t* p2_count,
+		uint8_t* to_move);
+
+// colex rank of a set of squares, and the rank of a set among the squares
+// not in 'excluded'. These are on every lookup's path, so are inline.
+static inline uint32_t db_rank_set(Bitboard set) {
+	uint32_t rank = 0;
+	for (uint8_t i = 1; set; i++) {
+		rank += db_choose[__builtin_ctz(set)][i];
+		set &= set - 1;
+	}
+	return rank;
+}
+
+static inline uint32_t db_rank_set_excluding(Bitboard set, Bitboard excluded) {
+	uint32_t rank = 0;
+	for (uint8_t i = 1; set; i++) {
+		uint8_t square = __builtin_ctz(set);
+		// number the square as if the excluded squares weren't there.
+		// There are at most four of them, so they are counted one at a time
+		// (without a popcount instruction, __builtin_popcount is a call).
+		for (Bitboard below = excluded & (((Bitboard)1 << square) - 1);
+				below; below &= below - 1) {
+			square--;
+		}
+		rank += db_choose[square][i];
+		set &= set - 1;
+	}
+	return rank;
+}
+
+// returns the index of a position among all the positions in its layer
+static inline uint32_t db_layer_index(uint8_t p1_count, uint8_t p2_count,
+		Bitboard p1, Bitboard p2) {
+	return db_rank_set(p1) * db_choose[NUM_SQUARES - p1_count][p2_count] +
+			db_rank_set_excluding(p2, p1);
+}
+
+// Work out which sets of squares are canonical and number them (for
+// writing a database; readers use the tables stored in the file). Then
+// db_class_count gives the number of canonical sets of 'count' squares,
+// and db_class_table the class table (indexed by colex rank) for them.
+void db_build_class_tables(void);
+uint32_t db_class_count(uint8_t count);
+const uint16_t* db_class_table(uint8_t count);
+
+
+#endif /* DBFORMAT_H_ */
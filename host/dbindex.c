@@ -0,0 +1,104 @@
+/*
+ * dbindex.c
+ *
+ * Combinatorial ranking of positions and the symmetry class tables used to
+ * number positions in the database. See dbformat.h.
+ */
+
+#include "dbformat.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "symmetry.h"
+
+uint32_t db_choose[NUM_SQUARES + 1][PIECES_PER_PLAYER + 1];
+
+static uint16_t* class_tables[PIECES_PER_PLAYER + 1];
+static uint32_t class_counts[PIECES_PER_PLAYER + 1];
+
+// returns the next larger number with the same number of bits set
+// (Gosper's hack). Sets of squares visited in this order are in colex order.
+static Bitboard next_set(Bitboard set) {
+	Bitboard lowest = set & -set;
+	Bitboard ripple = set + lowest;
+	return ripple | (((set ^ ripple) >> 2) / lowest);
+}
+
+static uint8_t is_canonical_set(Bitboard set) {
+	for (uint8_t symmetry = 1; symmetry < NUM_SYMMETRIES; symmetry++) {
+		if (transform_bitboard(symmetry, set) < set) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static pthread_once_t index_once = PTHREAD_ONCE_INIT;
+
+static void fill_choose(void) {
+	for (uint8_t n = 0; n <= NUM_SQUARES; n++) {
+		db_choose[n][0] = 1;
+		for (uint8_t k = 1; k <= PIECES_PER_PLAYER; k++) {
+			db_choose[n][k] = (n == 0) ? 0 :
+					db_choose[n - 1][k - 1] + db_choose[n - 1][k];
+		}
+	}
+}
+
+void db_init_index(void) {
+	// the table is filled in once, so opening a database while other
+	// threads are reading it is safe
+	pthread_once(&index_once, fill_choose);
+}
+
+void db_build_class_tables(void) {
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		uint32_t num_sets = db_choose[NUM_SQUARES][count];
+		class_tables[count] = malloc(num_sets * sizeof(uint16_t));
+		class_counts[count] = 0;
+		Bitboard set = ((Bitboard)1 << count) - 1;
+		for (uint32_t rank = 0; rank < num_sets; rank++) {
+			class_tables[count][rank] = is_canonical_set(set) ?
+					class_counts[count]++ : DB_NO_CLASS;
+			if (count > 0) {
+				set = next_set(set);
+			}
+		}
+	}
+}
+
+uint8_t db_layer(uint8_t p1_count, uint8_t p2_count, uint8_t to_move) {
+	if (p1_count > PIECES_PER_PLAYER || p2_count > p1_count ||
+			p1_count > p2_count + 1 ||
+			(to_move != PLAYER_1 && to_move != PLAYER_2)) {
+		return DB_NO_LAYER;
+	}
+	uint8_t placed = p1_count + p2_count;
+	if (placed < 2 * PIECES_PER_PLAYER) {
+		// player 1 drops first, so is to move whenever the counts are equal
+		uint8_t expected = (p1_count == p2_count) ? PLAYER_1 : PLAYER_2;
+		return (to_move == expected) ? placed : DB_NO_LAYER;
+	}
+	return placed + (to_move == PLAYER_2);
+}
+
+void db_layer_shape(uint8_t layer, uint8_t* p1_count, uint8_t* p2_count,
+		uint8_t* to_move) {
+	if (layer >= 2 * PIECES_PER_PLAYER) {
+		*p1_count = PIECES_PER_PLAYER;
+		*p2_count = PIECES_PER_PLAYER;
+		*to_move = (layer == 2 * PIECES_PER_PLAYER) ? PLAYER_1 : PLAYER_2;
+	} else {
+		*p1_count = (layer + 1) / 2;
+		*p2_count = layer / 2;
+		*to_move = (layer & 1) ? PLAYER_2 : PLAYER_1;
+	}
+}
+
+uint32_t db_class_count(uint8_t count) {
+	return class_counts[count];
+}
+
+const uint16_t* db_class_table(uint8_t count) {
+	return class_tables[count];
+}
@@ -0,0 +1,251 @@
+/*
+ * query.c
+ *
+ * teeko-query: looks positions up in a solved Teeko database.
+ *
+ * usage: teeko-query [-b count] [-c count] database [board [player]]
+ *
+ * 'board' is 25 characters, one per square from square 0 (bottom left)
+ * along each row to square 24 (top right): '.' for empty, '1' or '2' for
+ * a player's piece. The player to move defaults to whoever's turn it is in
+ * the drop phase, and to player 1 in the movement phase. With no board the
+ * empty board is used.
+ *
+ * -b count	time 'count' lookups of random positions, then 'count' / 25
+ *			best move searches
+ * -c count	check 'count' random positions agree with the positions one
+ *			move later (a regression test for the database)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "teeko.h"
+#include "teekodb.h"
+
+static void usage(const char* program) {
+	fprintf(stderr, "usage: %s [-b count] [-c count] database [board [player]]\n",
+			program);
+	exit(1);
+}
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t random_number(void) {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return random_state >> 32;
+}
+
+static Bitboard random_pieces(Bitboard occupied, uint8_t count) {
+	Bitboard pieces = 0;
+	while (count) {
+		Bitboard bit = (Bitboard)1 << (random_number() % NUM_SQUARES);
+		if (!((occupied | pieces) & bit)) {
+			pieces |= bit;
+			count--;
+		}
+	}
+	return pieces;
+}
+
+// a random position with legal piece counts for the player to move
+static void random_position(Bitboard* p1, Bitboard* p2, uint8_t* to_move) {
+	uint8_t placed = random_number() % (2 * PIECES_PER_PLAYER + 2);
+	if (placed > 2 * PIECES_PER_PLAYER) {
+		placed = 2 * PIECES_PER_PLAYER;
+		*to_move = PLAYER_2;
+	} else {
+		*to_move = (placed & 1) ? PLAYER_2 : PLAYER_1;
+	}
+	*p1 = random_pieces(0, (placed + 1) / 2);
+	*p2 = random_pieces(*p1, placed / 2);
+}
+
+static double now_seconds(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void benchmark(const TeekoDb* db, uint32_t count) {
+	enum { BATCH = 4096 };
+	static Bitboard p1s[BATCH], p2s[BATCH];
+	static uint8_t players[BATCH];
+	for (uint32_t i = 0; i < BATCH; i++) {
+		random_position(&p1s[i], &p2s[i], &players[i]);
+	}
+	uint32_t checksum = 0;
+	double start = now_seconds();
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t j = i % BATCH;
+		checksum += teekodb_value(db, p1s[j], p2s[j], players[j]);
+	}
+	double elapsed = now_seconds() - start;
+	printf("%u lookups in %.3fs: %.1f ns each (checksum %u)\n", count,
+			elapsed, elapsed * 1e9 / count, checksum);
+
+	// a best move search looks up every move, so takes about as long as
+	// 25 lookups in the drop phase
+	uint32_t searches = (count + 24) / 25;
+	MoveCode moves[MAX_MOVES];
+	checksum = 0;
+	start = now_seconds();
+	for (uint32_t i = 0; i < searches; i++) {
+		uint32_t j = i % BATCH;
+		checksum += teekodb_best_moves(db, p1s[j], p2s[j], players[j], moves,
+				NULL);
+	}
+	elapsed = now_seconds() - start;
+	printf("%u best move searches in %.3fs: %.2f us each (checksum %u)\n",
+			searches, elapsed, elapsed * 1e6 / searches, checksum);
+}
+
+// returns the value a position should have given the values one move on
+static uint8_t value_from_children(const TeekoDb* db, Bitboard p1,
+		Bitboard p2, uint8_t to_move) {
+	uint8_t next_player = (to_move == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	Bitboard own = (to_move == PLAYER_1) ? p1 : p2;
+	MoveCode moves[MAX_MOVES];
+	uint8_t num_moves = generate_moves(own, p1 | p2,
+			__builtin_popcount(p1 | p2), moves);
+	uint8_t quickest_win = 0, slowest_loss = 0, any_draw = 0;
+	for (uint8_t i = 0; i < num_moves; i++) {
+		Bitboard change = (Bitboard)1 << move_to(moves[i]);
+		if (move_from(moves[i]) != NO_SQUARE) {
+			change |= (Bitboard)1 << move_from(moves[i]);
+		}
+		uint8_t child = (to_move == PLAYER_1) ?
+				teekodb_value(db, p1 ^ change, p2, next_player) :
+				teekodb_value(db, p1, p2 ^ change, next_player);
+		if (child == DB_DRAW) {
+			any_draw = 1;
+		} else if (DB_IS_LOSS(child)) {
+			if (!quickest_win || child + 1 < quickest_win) {
+				quickest_win = child + 1;
+			}
+		} else if (child + 1 > slowest_loss) {
+			slowest_loss = child + 1;
+		}
+	}
+	if (quickest_win) {
+		return quickest_win;
+	} else if (any_draw || num_moves == 0) {
+		return DB_DRAW;
+	}
+	return slowest_loss;
+}
+
+static int check(const TeekoDb* db, uint32_t count) {
+	uint32_t checked = 0, failures = 0;
+	while (checked < count) {
+		Bitboard p1, p2;
+		uint8_t to_move;
+		random_position(&p1, &p2, &to_move);
+		uint8_t value = teekodb_value(db, p1, p2, to_move);
+		uint8_t other_won = pieces_have_won((to_move == PLAYER_1) ? p2 : p1);
+		uint8_t expected;
+		if (pieces_have_won((to_move == PLAYER_1) ? p1 : p2)) {
+			expected = DB_INVALID;
+		} else if (other_won) {
+			expected = DB_VALUE(0);
+		} else {
+			expected = value_from_children(db, p1, p2, to_move);
+		}
+		if (value != expected) {
+			failures++;
+			printf("mismatch: p1 %07X p2 %07X player %u to move: stored %u, "
+					"expected %u\n", p1, p2, to_move, value, expected);
+		}
+		checked++;
+	}
+	printf("checked %u positions, %u mismatches\n", checked, failures);
+	return failures != 0;
+}
+
+static void describe_value(uint8_t value) {
+	if (value == DB_INVALID) {
+		printf("impossible position\n");
+	} else if (value == DB_DRAW) {
+		printf("draw\n");
+	} else {
+		printf("%s in %u plies\n", DB_IS_WIN(value) ? "win" : "loss",
+				DB_DISTANCE(value));
+	}
+}
+
+int main(int argc, char** argv) {
+	uint32_t benchmark_count = 0, check_count = 0;
+	int option;
+	while ((option = getopt(argc, argv, "b:c:")) != -1) {
+		if (option == 'b') {
+			benchmark_count = strtoul(optarg, NULL, 10);
+		} else if (option == 'c') {
+			check_count = strtoul(optarg, NULL, 10);
+		} else {
+			usage(argv[0]);
+		}
+	}
+	if (optind >= argc || argc - optind > 3) {
+		usage(argv[0]);
+	}
+
+	double start = now_seconds();
+	TeekoDb* db = teekodb_open(argv[optind]);
+	if (!db) {
+		return 1;
+	}
+	printf("opened in %.1f us\n", (now_seconds() - start) * 1e6);
+
+	if (benchmark_count) {
+		benchmark(db, benchmark_count);
+	}
+	if (check_count) {
+		return check(db, check_count);
+	}
+	if (benchmark_count) {
+		return 0;
+	}
+
+	Bitboard p1 = 0, p2 = 0;
+	if (argc - optind >= 2) {
+		const char* board = argv[optind + 1];
+		if (strlen(board) != NUM_SQUARES) {
+			usage(argv[0]);
+		}
+		for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+			if (board[square] == '1') {
+				p1 |= (Bitboard)1 << square;
+			} else if (board[square] == '2') {
+				p2 |= (Bitboard)1 << square;
+			}
+		}
+	}
+	uint8_t p1_count = __builtin_popcount(p1);
+	uint8_t to_move = (p1_count > __builtin_popcount(p2)) ? PLAYER_2 : PLAYER_1;
+	if (argc - optind == 3) {
+		to_move = atoi(argv[optind + 2]);
+	}
+
+	MoveCode moves[MAX_MOVES];
+	uint8_t value;
+	uint8_t num_moves = teekodb_best_moves(db, p1, p2, to_move, moves, &value);
+	printf("player %u to move: ", to_move);
+	describe_value(value);
+	for (uint8_t i = 0; i < num_moves; i++) {
+		uint8_t from = move_from(moves[i]);
+		uint8_t to = move_to(moves[i]);
+		if (from == NO_SQUARE) {
+			printf("  drop on (%u,%u)\n", to % WIDTH, to / WIDTH);
+		} else {
+			printf("  move (%u,%u) to (%u,%u)\n", from % WIDTH, from / WIDTH,
+					to % WIDTH, to / WIDTH);
+		}
+	}
+	teekodb_close(db);
+	return 0;
+}
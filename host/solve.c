@@ -0,0 +1,502 @@
+/*
+ * solve.c
+ *
+ * teeko-solve: works out the value of every Teeko position with perfect
+ * play and writes the database described in dbformat.h.
+ *
+ * usage: teeko-solve [-j threads] output-file
+ *
+ * The movement phase can go round in circles, so it is solved by
+ * retrograde analysis. Positions where the player to move has already
+ * lost are found first; then, one ply at a time, the predecessors of the
+ * positions just decided are updated: a predecessor with a move into a
+ * lost position is won, and one whose moves all lead to won positions is
+ * lost. Whatever is left undecided is a draw. The drop phase can't repeat,
+ * so it is then solved backwards one piece count at a time.
+ *
+ * Every pass is split across threads by player 1's pieces. Positions are
+ * updated with atomic operations rather than locks: a compare-and-swap
+ * claims a newly won position, and an atomic decrement of its count of
+ * undecided moves tells a thread when it has found a lost one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include "teeko.h"
+#include "dbformat.h"
+
+#define MOVEMENT_LAYER (2 * PIECES_PER_PLAYER)
+#define FILE_ALIGNMENT 64
+
+// every set of 0 to 4 squares, in colex (rank) order
+static Bitboard* sets[PIECES_PER_PLAYER + 1];
+// for each set of 4 squares (by rank), whether it is a winning pattern
+static uint8_t* set_has_won;
+
+// value of each position, at layer_offsets[layer] + its index in the layer
+static uint8_t* values;
+static uint64_t layer_offsets[DB_NUM_LAYERS + 1];
+// for undecided movement phase positions, the number of moves which don't
+// yet lead to a won position (indexed from layer_offsets[MOVEMENT_LAYER])
+static uint8_t* move_counts;
+
+static unsigned num_threads;
+static uint8_t current_layer;
+static uint8_t current_distance;
+static uint64_t decided_count;
+
+/*
+ * Work sharing. run_parallel() calls work(item) for every item from 0 to
+ * num_items-1, with threads taking the next item as they finish one.
+ */
+static void (*work_function)(uint32_t item);
+static uint32_t work_items;
+static uint32_t next_work_item;
+
+static void* worker(void* unused) {
+	(void)unused;
+	for (;;) {
+		uint32_t item = __atomic_fetch_add(&next_work_item, 1, __ATOMIC_RELAXED);
+		if (item >= work_items) {
+			return NULL;
+		}
+		work_function(item);
+	}
+}
+
+static void run_parallel(void (*work)(uint32_t item), uint32_t num_items) {
+	pthread_t threads[num_threads];
+	work_function = work;
+	work_items = num_items;
+	next_work_item = 0;
+	for (unsigned i = 0; i < num_threads; i++) {
+		if (pthread_create(&threads[i], NULL, worker, NULL) != 0) {
+			perror("pthread_create");
+			exit(1);
+		}
+	}
+	for (unsigned i = 0; i < num_threads; i++) {
+		pthread_join(threads[i], NULL);
+	}
+}
+
+// returns the next larger number with the same number of bits set
+static uint32_t next_set(uint32_t set) {
+	uint32_t lowest = set & -set;
+	uint32_t ripple = set + lowest;
+	return ripple | (((set ^ ripple) >> 2) / lowest);
+}
+
+// Visits the sets of 'count' squares not in 'excluded' in rank order.
+// Squares are numbered among the free ones, the set is built up in that
+// numbering and then spread back out over the real squares.
+typedef struct {
+	uint8_t free_squares[NUM_SQUARES];
+	uint32_t compact;
+	uint32_t remaining;
+} SetWalk;
+
+static void start_walk(SetWalk* walk, Bitboard excluded, uint8_t count) {
+	uint8_t num_free = 0;
+	for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+		if (!(excluded & ((Bitboard)1 << square))) {
+			walk->free_squares[num_free++] = square;
+		}
+	}
+	walk->compact = ((uint32_t)1 << count) - 1;
+	walk->remaining = db_choose[num_free][count];
+}
+
+static Bitboard walk_set(SetWalk* walk) {
+	Bitboard set = 0;
+	for (uint32_t compact = walk->compact; compact; compact &= compact - 1) {
+		set |= (Bitboard)1 << walk->free_squares[__builtin_ctz(compact)];
+	}
+	return set;
+}
+
+static void advance_walk(SetWalk* walk) {
+	if (walk->compact) {
+		walk->compact = next_set(walk->compact);
+	}
+	walk->remaining--;
+}
+
+static uint8_t count_moves(Bitboard own, Bitboard occupied) {
+	uint8_t count = 0;
+	while (own) {
+		uint8_t from = __builtin_ctz(own);
+		own &= own - 1;
+		count += __builtin_popcount(get_neighbours(from) & ~occupied);
+	}
+	return count;
+}
+
+static uint64_t position_offset(uint8_t layer, Bitboard p1, Bitboard p2) {
+	uint8_t p1_count, p2_count, to_move;
+	db_layer_shape(layer, &p1_count, &p2_count, &to_move);
+	return layer_offsets[layer] + db_layer_index(p1_count, p2_count, p1, p2);
+}
+
+/*
+ * Movement phase: find the lost and impossible positions, and count the
+ * moves from all the others. Work item is the rank of player 1's pieces.
+ */
+static void find_terminal_positions(uint32_t p1_rank) {
+	Bitboard p1 = sets[PIECES_PER_PLAYER][p1_rank];
+	uint8_t p1_won = set_has_won[p1_rank];
+	uint32_t p2_sets = db_choose[NUM_SQUARES - PIECES_PER_PLAYER][PIECES_PER_PLAYER];
+	uint64_t decided = 0;
+	SetWalk walk;
+	start_walk(&walk, p1, PIECES_PER_PLAYER);
+	for (uint32_t p2_rank = 0; walk.remaining; p2_rank++, advance_walk(&walk)) {
+		Bitboard p2 = walk_set(&walk);
+		uint8_t p2_won = set_has_won[db_rank_set(p2)];
+		uint64_t index = (uint64_t)p1_rank * p2_sets + p2_rank;
+		for (uint8_t to_move = PLAYER_1; to_move <= PLAYER_2; to_move++) {
+			uint8_t layer = MOVEMENT_LAYER + (to_move - PLAYER_1);
+			uint64_t offset = layer_offsets[layer] + index;
+			uint8_t mover_won = (to_move == PLAYER_1) ? p1_won : p2_won;
+			uint8_t other_won = (to_move == PLAYER_1) ? p2_won : p1_won;
+			if (mover_won) {
+				// the game would already have ended
+				values[offset] = DB_INVALID;
+			} else if (other_won) {
+				values[offset] = DB_VALUE(0);
+				decided++;
+			} else {
+				// a player with no moves at all stays undecided (a draw)
+				move_counts[offset - layer_offsets[MOVEMENT_LAYER]] =
+						count_moves(to_move == PLAYER_1 ? p1 : p2, p1 | p2);
+			}
+		}
+	}
+	__atomic_add_fetch(&decided_count, decided, __ATOMIC_RELAXED);
+}
+
+/*
+ * Movement phase: update the predecessors of every position decided at
+ * current_distance. Work item is the rank of player 1's pieces.
+ */
+static void propagate_distance(uint32_t p1_rank) {
+	Bitboard p1 = sets[PIECES_PER_PLAYER][p1_rank];
+	uint32_t p2_sets = db_choose[NUM_SQUARES - PIECES_PER_PLAYER][PIECES_PER_PLAYER];
+	uint8_t value = DB_VALUE(current_distance);
+	uint8_t new_value = DB_VALUE(current_distance + 1);
+	uint8_t lost = !(current_distance & 1);
+	uint64_t decided = 0;
+	SetWalk walk;
+	start_walk(&walk, p1, PIECES_PER_PLAYER);
+	for (uint32_t p2_rank = 0; walk.remaining; p2_rank++, advance_walk(&walk)) {
+		uint64_t index = (uint64_t)p1_rank * p2_sets + p2_rank;
+		for (uint8_t to_move = PLAYER_1; to_move <= PLAYER_2; to_move++) {
+			uint8_t layer = MOVEMENT_LAYER + (to_move - PLAYER_1);
+			if (values[layer_offsets[layer] + index] != value) {
+				continue;
+			}
+			// undo each possible last move, by the player not to move
+			Bitboard p2 = walk_set(&walk);
+			Bitboard occupied = p1 | p2;
+			uint8_t mover = (to_move == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+			uint8_t mover_layer = MOVEMENT_LAYER + (mover - PLAYER_1);
+			Bitboard mover_pieces = (mover == PLAYER_1) ? p1 : p2;
+			for (Bitboard pieces = mover_pieces; pieces; pieces &= pieces - 1) {
+				uint8_t to = __builtin_ctz(pieces);
+				Bitboard sources = get_neighbours(to) & ~occupied;
+				for (; sources; sources &= sources - 1) {
+					Bitboard before = mover_pieces ^ ((Bitboard)1 << to) ^
+							((Bitboard)1 << __builtin_ctz(sources));
+					uint64_t offset = (mover == PLAYER_1) ?
+							position_offset(mover_layer, before, p2) :
+							position_offset(mover_layer, p1, before);
+					if (__atomic_load_n(&values[offset], __ATOMIC_RELAXED) != DB_DRAW) {
+						continue;
+					}
+					if (lost) {
+						// moving here wins, and this is the quickest win
+						uint8_t expected = DB_DRAW;
+						if (__atomic_compare_exchange_n(&values[offset],
+								&expected, new_value, 0, __ATOMIC_RELAXED,
+								__ATOMIC_RELAXED)) {
+							decided++;
+						}
+					} else if (__atomic_sub_fetch(&move_counts[offset -
+							layer_offsets[MOVEMENT_LAYER]], 1,
+							__ATOMIC_RELAXED) == 0) {
+						// every move loses, and this is the slowest loss
+						__atomic_store_n(&values[offset], new_value,
+								__ATOMIC_RELAXED);
+						decided++;
+					}
+				}
+			}
+		}
+	}
+	__atomic_add_fetch(&decided_count, decided, __ATOMIC_RELAXED);
+}
+
+/*
+ * Drop phase: decide every position in current_layer from the positions
+ * one drop later. Work item is the rank of player 1's pieces.
+ */
+static void solve_drop_layer(uint32_t p1_rank) {
+	uint8_t p1_count, p2_count, to_move;
+	db_layer_shape(current_layer, &p1_count, &p2_count, &to_move);
+	Bitboard p1 = sets[p1_count][p1_rank];
+	uint8_t p1_won = (p1_count == PIECES_PER_PLAYER) && set_has_won[p1_rank];
+	uint32_t p2_sets = db_choose[NUM_SQUARES - p1_count][p2_count];
+	uint8_t next_layer = db_layer(p1_count + (to_move == PLAYER_1),
+			p2_count + (to_move == PLAYER_2),
+			(to_move == PLAYER_1) ? PLAYER_2 : PLAYER_1);
+	if (next_layer == DB_NO_LAYER) {
+		// the last drop leads to the movement phase with player 1 to move
+		next_layer = MOVEMENT_LAYER;
+	}
+	SetWalk walk;
+	start_walk(&walk, p1, p2_count);
+	for (uint32_t p2_rank = 0; walk.remaining; p2_rank++, advance_walk(&walk)) {
+		Bitboard p2 = walk_set(&walk);
+		uint64_t offset = layer_offsets[current_layer] +
+				(uint64_t)p1_rank * p2_sets + p2_rank;
+		if (p1_won) {
+			// player 1's fourth drop won the game (player 2 can't have
+			// four pieces yet)
+			values[offset] = DB_VALUE(0);
+			continue;
+		}
+		// the quickest win if any drop wins, else the slowest loss if
+		// every drop loses, else a draw
+		uint8_t quickest_win = 0;
+		uint8_t slowest_loss = 0;
+		uint8_t any_draw = 0;
+		for (Bitboard empty = ~(p1 | p2) & BOARD_MASK; empty; empty &= empty - 1) {
+			Bitboard bit = empty & -empty;
+			uint8_t child = (to_move == PLAYER_1) ?
+					values[position_offset(next_layer, p1 | bit, p2)] :
+					values[position_offset(next_layer, p1, p2 | bit)];
+			if (child == DB_INVALID) {
+				continue;
+			} else if (child == DB_DRAW) {
+				any_draw = 1;
+			} else if (DB_IS_LOSS(child)) {
+				if (!quickest_win || child + 1 < quickest_win) {
+					quickest_win = child + 1;
+				}
+			} else if (child + 1 > slowest_loss) {
+				slowest_loss = child + 1;
+			}
+		}
+		if (quickest_win) {
+			values[offset] = quickest_win;
+		} else if (any_draw) {
+			values[offset] = DB_DRAW;
+		} else {
+			values[offset] = slowest_loss;
+		}
+	}
+}
+
+static double seconds_since(const struct timespec* start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void build_tables(void) {
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		uint32_t num_sets = db_choose[NUM_SQUARES][count];
+		sets[count] = malloc(num_sets * sizeof(Bitboard));
+		Bitboard set = ((Bitboard)1 << count) - 1;
+		for (uint32_t rank = 0; rank < num_sets; rank++) {
+			sets[count][rank] = set;
+			if (count > 0) {
+				set = next_set(set);
+			}
+		}
+	}
+	uint32_t num_full_sets = db_choose[NUM_SQUARES][PIECES_PER_PLAYER];
+	set_has_won = malloc(num_full_sets);
+	for (uint32_t rank = 0; rank < num_full_sets; rank++) {
+		set_has_won[rank] = pieces_have_won(sets[PIECES_PER_PLAYER][rank]);
+	}
+
+	layer_offsets[0] = 0;
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		uint8_t p1_count, p2_count, to_move;
+		db_layer_shape(layer, &p1_count, &p2_count, &to_move);
+		layer_offsets[layer + 1] = layer_offsets[layer] +
+				(uint64_t)db_choose[NUM_SQUARES][p1_count] *
+				db_choose[NUM_SQUARES - p1_count][p2_count];
+	}
+	values = calloc(layer_offsets[DB_NUM_LAYERS], 1);
+	move_counts = calloc(layer_offsets[DB_NUM_LAYERS] -
+			layer_offsets[MOVEMENT_LAYER], 1);
+	if (!values || !move_counts) {
+		fprintf(stderr, "teeko-solve: out of memory\n");
+		exit(1);
+	}
+}
+
+static uint64_t align_offset(uint64_t offset) {
+	return (offset + FILE_ALIGNMENT - 1) & ~(uint64_t)(FILE_ALIGNMENT - 1);
+}
+
+static void write_padding(FILE* file, uint64_t offset) {
+	while ((uint64_t)ftell(file) < offset) {
+		fputc(0, file);
+	}
+}
+
+// writes the values of the positions whose player 1 pieces are canonical
+static void write_database(const char* filename) {
+	DbHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, DB_MAGIC, sizeof(header.magic));
+	header.version = DB_VERSION;
+	header.num_layers = DB_NUM_LAYERS;
+
+	uint64_t offset = align_offset(sizeof(header));
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		header.class_table_offsets[count] = offset;
+		header.class_counts[count] = db_class_count(count);
+		offset = align_offset(offset +
+				db_choose[NUM_SQUARES][count] * sizeof(uint16_t));
+	}
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		DbLayerHeader* layer_header = &header.layers[layer];
+		db_layer_shape(layer, &layer_header->p1_count,
+				&layer_header->p2_count, &layer_header->to_move);
+		layer_header->p2_sets = db_choose[NUM_SQUARES -
+				layer_header->p1_count][layer_header->p2_count];
+		layer_header->offset = offset;
+		offset = align_offset(offset + (uint64_t)layer_header->p2_sets *
+				header.class_counts[layer_header->p1_count]);
+	}
+
+	FILE* file = fopen(filename, "wb");
+	if (!file) {
+		perror(filename);
+		exit(1);
+	}
+	fwrite(&header, sizeof(header), 1, file);
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		write_padding(file, header.class_table_offsets[count]);
+		fwrite(db_class_table(count), sizeof(uint16_t),
+				db_choose[NUM_SQUARES][count], file);
+	}
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		DbLayerHeader* layer_header = &header.layers[layer];
+		const uint16_t* classes = db_class_table(layer_header->p1_count);
+		write_padding(file, layer_header->offset);
+		for (uint32_t rank = 0; rank < db_choose[NUM_SQUARES][layer_header->p1_count];
+				rank++) {
+			if (classes[rank] != DB_NO_CLASS) {
+				fwrite(&values[layer_offsets[layer] +
+						(uint64_t)rank * layer_header->p2_sets], 1,
+						layer_header->p2_sets, file);
+			}
+		}
+	}
+	write_padding(file, offset);
+	if (fclose(file) != 0) {
+		perror(filename);
+		exit(1);
+	}
+	printf("wrote %s (%llu bytes)\n", filename, (unsigned long long)offset);
+}
+
+static void print_summary(void) {
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		uint64_t wins = 0, losses = 0, draws = 0, invalid = 0;
+		uint8_t longest = 0;
+		for (uint64_t i = layer_offsets[layer]; i < layer_offsets[layer + 1]; i++) {
+			uint8_t value = values[i];
+			if (value == DB_INVALID) {
+				invalid++;
+			} else if (value == DB_DRAW) {
+				draws++;
+			} else {
+				if (DB_IS_WIN(value)) {
+					wins++;
+				} else {
+					losses++;
+				}
+				if (DB_DISTANCE(value) > longest) {
+					longest = DB_DISTANCE(value);
+				}
+			}
+		}
+		uint8_t p1_count, p2_count, to_move;
+		db_layer_shape(layer, &p1_count, &p2_count, &to_move);
+		printf("layer %u (%u+%u, player %u to move): %llu won, %llu lost, "
+				"%llu drawn, %llu impossible, longest %u plies\n",
+				layer, p1_count, p2_count, to_move,
+				(unsigned long long)wins, (unsigned long long)losses,
+				(unsigned long long)draws, (unsigned long long)invalid, longest);
+	}
+	uint8_t start = values[0];
+	printf("start position: %s\n", start == DB_DRAW ? "draw" :
+			DB_IS_WIN(start) ? "first player wins" : "first player loses");
+}
+
+int main(int argc, char** argv) {
+	int option;
+	num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	while ((option = getopt(argc, argv, "j:")) != -1) {
+		if (option == 'j' && atoi(optarg) > 0) {
+			num_threads = atoi(optarg);
+		} else {
+			fprintf(stderr, "usage: %s [-j threads] output-file\n", argv[0]);
+			return 1;
+		}
+	}
+	if (optind != argc - 1) {
+		fprintf(stderr, "usage: %s [-j threads] output-file\n", argv[0]);
+		return 1;
+	}
+
+	struct timespec start;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	db_init_index();
+	db_build_class_tables();
+	build_tables();
+	uint32_t full_sets = db_choose[NUM_SQUARES][PIECES_PER_PLAYER];
+	printf("%llu positions, %u threads\n",
+			(unsigned long long)layer_offsets[DB_NUM_LAYERS], num_threads);
+
+	decided_count = 0;
+	run_parallel(find_terminal_positions, full_sets);
+	printf("distance 0: %llu positions (%.1fs)\n",
+			(unsigned long long)decided_count, seconds_since(&start));
+	for (current_distance = 0; ; current_distance++) {
+		if (current_distance == DB_MAX_DISTANCE) {
+			fprintf(stderr, "teeko-solve: distance too large to store\n");
+			return 1;
+		}
+		decided_count = 0;
+		run_parallel(propagate_distance, full_sets);
+		if (decided_count == 0) {
+			break;
+		}
+		printf("distance %u: %llu positions (%.1fs)\n", current_distance + 1,
+				(unsigned long long)decided_count, seconds_since(&start));
+		fflush(stdout);
+	}
+
+	for (int layer = MOVEMENT_LAYER - 1; layer >= 0; layer--) {
+		uint8_t p1_count, p2_count, to_move;
+		current_layer = layer;
+		db_layer_shape(layer, &p1_count, &p2_count, &to_move);
+		run_parallel(solve_drop_layer, db_choose[NUM_SQUARES][p1_count]);
+	}
+	printf("drop phase solved (%.1fs)\n", seconds_since(&start));
+
+	print_summary();
+	write_database(argv[optind]);
+	return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * teekodb.c
+ *
+ * Memory-mapped Teeko database lookups. A position is found by putting it
+ * into canonical form (symmetry.h), looking up the class of player 1's
+ * pieces in the file's class table and ranking player 2's pieces among
+ * the free squares. See dbformat.h for the layout.
+ *
+ * Transforming a bitboard a square at a time (as transform_bitboard() does
+ * for the firmware) took most of a lookup's time, so here each symmetry
+ * is applied a row at a time from tables. A symmetry sends each square to
+ * one square, so the image of a set is the XOR of the images of its
+ * parts. That lets teekodb_best_moves() transform the position once and
+ * get the image of each position one move on by XORing in the image of
+ * the squares the move changes.
+ */
+
+#include "teekodb.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "symmetry.h"
+
+// row_images[s][y][bits] is the image under symmetry s of the squares of
+// row y given by the WIDTH bits 'bits'
+static Bitboard row_images[NUM_SYMMETRIES][HEIGHT][1 << WIDTH];
+// square_images[s][i] is the image of square i under symmetry s, with an
+// extra entry of 0 standing for NO_SQUARE (the square a drop comes from)
+static Bitboard square_images[NUM_SYMMETRIES][NUM_SQUARES + 1];
+static pthread_once_t symmetry_tables_once = PTHREAD_ONCE_INIT;
+
+static void fill_symmetry_tables(void) {
+	for (uint8_t symmetry = 0; symmetry < NUM_SYMMETRIES; symmetry++) {
+		for (uint8_t square = 0; square < NUM_SQUARES; square++) {
+			square_images[symmetry][square] =
+					(Bitboard)1 << transform_square(symmetry, square);
+		}
+		square_images[symmetry][NUM_SQUARES] = 0;
+		for (uint8_t y = 0; y < HEIGHT; y++) {
+			for (uint8_t bits = 0; bits < (1 << WIDTH); bits++) {
+				row_images[symmetry][y][bits] = transform_bitboard(symmetry,
+						(Bitboard)bits << (y * WIDTH));
+			}
+		}
+	}
+}
+
+// fills images[s] with 'pieces' transformed by each symmetry s
+static void transform_all(Bitboard pieces, Bitboard images[NUM_SYMMETRIES]) {
+	for (uint8_t symmetry = 0; symmetry < NUM_SYMMETRIES; symmetry++) {
+		Bitboard image = 0;
+		Bitboard rows = pieces;
+		for (uint8_t y = 0; rows; y++) {
+			image |= row_images[symmetry][y][rows & ((1 << WIDTH) - 1)];
+			rows >>= WIDTH;
+		}
+		images[symmetry] = image;
+	}
+}
+
+struct TeekoDb {
+	const uint8_t* data;
+	size_t size;
+	const uint16_t* class_tables[PIECES_PER_PLAYER + 1];
+	const uint8_t* layers[DB_NUM_LAYERS];
+	uint32_t p2_sets[DB_NUM_LAYERS];
+};
+
+// Checks everything a lookup relies on, so that no lookup can read
+// outside the file however it has been damaged: the header, the shape of
+// each layer, and that the class tables and layers lie within the file
+// and every class number in the tables has a place in the layers.
+static uint8_t is_valid_database(const uint8_t* data, size_t size) {
+	const DbHeader* header = (const DbHeader*)data;
+	if (memcmp(header->magic, DB_MAGIC, sizeof(header->magic)) != 0 ||
+			header->version != DB_VERSION ||
+			header->num_layers != DB_NUM_LAYERS) {
+		return 0;
+	}
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		uint32_t num_sets = db_choose[NUM_SQUARES][count];
+		uint64_t offset = header->class_table_offsets[count];
+		if (header->class_counts[count] > num_sets ||
+				offset % sizeof(uint16_t) != 0 || offset > size ||
+				(size - offset) / sizeof(uint16_t) < num_sets) {
+			return 0;
+		}
+		const uint16_t* table = (const uint16_t*)(data + offset);
+		for (uint32_t rank = 0; rank < num_sets; rank++) {
+			if (table[rank] != DB_NO_CLASS &&
+					table[rank] >= header->class_counts[count]) {
+				return 0;
+			}
+		}
+	}
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		const DbLayerHeader* layer_header = &header->layers[layer];
+		uint8_t p1_count, p2_count, to_move;
+		db_layer_shape(layer, &p1_count, &p2_count, &to_move);
+		if (layer_header->p1_count != p1_count ||
+				layer_header->p2_count != p2_count ||
+				layer_header->to_move != to_move ||
+				layer_header->p2_sets !=
+				db_choose[NUM_SQUARES - p1_count][p2_count] ||
+				layer_header->offset > size ||
+				(uint64_t)layer_header->p2_sets *
+				header->class_counts[p1_count] >
+				size - layer_header->offset) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+TeekoDb* teekodb_open(const char* filename) {
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		perror(filename);
+		return NULL;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(DbHeader)) {
+		fprintf(stderr, "%s: not a Teeko database\n", filename);
+		close(fd);
+		return NULL;
+	}
+	void* data = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		perror(filename);
+		return NULL;
+	}
+
+	db_init_index();
+	pthread_once(&symmetry_tables_once, fill_symmetry_tables);
+	if (!is_valid_database(data, info.st_size)) {
+		fprintf(stderr, "%s: not a Teeko database (or the wrong version)\n",
+				filename);
+		munmap(data, info.st_size);
+		return NULL;
+	}
+
+	const DbHeader* header = data;
+	TeekoDb* db = malloc(sizeof(TeekoDb));
+	if (!db) {
+		perror(filename);
+		munmap(data, info.st_size);
+		return NULL;
+	}
+	db->data = data;
+	db->size = info.st_size;
+	for (uint8_t count = 0; count <= PIECES_PER_PLAYER; count++) {
+		db->class_tables[count] = (const uint16_t*)(db->data +
+				header->class_table_offsets[count]);
+	}
+	for (uint8_t layer = 0; layer < DB_NUM_LAYERS; layer++) {
+		db->layers[layer] = db->data + header->layers[layer].offset;
+		db->p2_sets[layer] = header->layers[layer].p2_sets;
+	}
+	return db;
+}
+
+void teekodb_close(TeekoDb* db) {
+	if (db) {
+		munmap((void*)db->data, db->size);
+		free(db);
+	}
+}
+
+// Returns where the value of a position is stored (or NULL if the file has
+// no place for it), given its layer, player 1's piece count and both
+// players' pieces under every symmetry. Picks the canonical member of the
+// class as canonicalise_position() does: the smallest player 1 pieces,
+// ties broken by the smallest player 2 pieces.
+static const uint8_t* value_address(const TeekoDb* db, uint8_t layer,
+		uint8_t p1_count,
+		const Bitboard p1_images[NUM_SYMMETRIES],
+		const Bitboard p2_images[NUM_SYMMETRIES]) {
+	Bitboard p1 = p1_images[SYMMETRY_IDENTITY];
+	Bitboard p2 = p2_images[SYMMETRY_IDENTITY];
+	for (uint8_t symmetry = 1; symmetry < NUM_SYMMETRIES; symmetry++) {
+		if (p1_images[symmetry] < p1 ||
+				(p1_images[symmetry] == p1 && p2_images[symmetry] < p2)) {
+			p1 = p1_images[symmetry];
+			p2 = p2_images[symmetry];
+		}
+	}
+	uint32_t class_index = db->class_tables[p1_count][db_rank_set(p1)];
+	if (class_index == DB_NO_CLASS) {
+		// only a damaged file leaves a canonical set without a class
+		return NULL;
+	}
+	return &db->layers[layer][(size_t)class_index * db->p2_sets[layer] +
+			db_rank_set_excluding(p2, p1)];
+}
+
+static uint8_t lookup(const TeekoDb* db, uint8_t layer, uint8_t p1_count,
+		const Bitboard p1_images[NUM_SYMMETRIES],
+		const Bitboard p2_images[NUM_SYMMETRIES]) {
+	const uint8_t* address = value_address(db, layer, p1_count, p1_images,
+			p2_images);
+	return address ? *address : DB_INVALID;
+}
+
+// returns the layer of a position, or DB_NO_LAYER if it isn't a valid one
+static uint8_t position_layer(Bitboard p1, Bitboard p2, uint8_t to_move) {
+	// pieces off the board would be ranked and transformed outside the
+	// tables
+	if ((p1 & p2) || ((p1 | p2) & ~BOARD_MASK)) {
+		return DB_NO_LAYER;
+	}
+	return db_layer(__builtin_popcount(p1), __builtin_popcount(p2), to_move);
+}
+
+uint8_t teekodb_value(const TeekoDb* db, Bitboard p1, Bitboard p2,
+		uint8_t to_move) {
+	uint8_t layer = position_layer(p1, p2, to_move);
+	if (layer == DB_NO_LAYER) {
+		return DB_INVALID;
+	}
+	Bitboard p1_images[NUM_SYMMETRIES], p2_images[NUM_SYMMETRIES];
+	transform_all(p1, p1_images);
+	transform_all(p2, p2_images);
+	return lookup(db, layer, __builtin_popcount(p1), p1_images, p2_images);
+}
+
+uint8_t teekodb_best_moves(const TeekoDb* db, Bitboard p1, Bitboard p2,
+		uint8_t to_move, MoveCode* moves, uint8_t* value) {
+	uint8_t layer = position_layer(p1, p2, to_move);
+	uint8_t position_value = DB_INVALID;
+	Bitboard p1_images[NUM_SYMMETRIES], p2_images[NUM_SYMMETRIES];
+	uint8_t p1_count = __builtin_popcount(p1);
+	if (layer != DB_NO_LAYER) {
+		transform_all(p1, p1_images);
+		transform_all(p2, p2_images);
+		position_value = lookup(db, layer, p1_count, p1_images, p2_images);
+	}
+	if (value) {
+		*value = position_value;
+	}
+	if (position_value == DB_INVALID || (position_value != DB_DRAW &&
+			DB_DISTANCE(position_value) == 0)) {
+		// impossible, or the game is already over
+		return 0;
+	}
+
+	// a move is best if the position it leads to is worth exactly one ply
+	// less to the opponent (or is also a draw)
+	uint8_t wanted = (position_value == DB_DRAW) ? DB_DRAW : position_value - 1;
+	uint8_t p2_count = __builtin_popcount(p2);
+	uint8_t next_player = (to_move == PLAYER_1) ? PLAYER_2 : PLAYER_1;
+	Bitboard own = (to_move == PLAYER_1) ? p1 : p2;
+	MoveCode all_moves[MAX_MOVES];
+	uint8_t num_moves = generate_moves(own, p1 | p2, p1_count + p2_count,
+			all_moves);
+	if (num_moves == 0) {
+		return 0;
+	}
+	// every move is a drop or every move is a slide, so all the positions
+	// one move on are in the same layer
+	uint8_t drop = move_from(all_moves[0]) == NO_SQUARE;
+	uint8_t child_layer = db_layer(p1_count + (drop && to_move == PLAYER_1),
+			p2_count + (drop && to_move == PLAYER_2), next_player);
+
+	// The values one move on are scattered through the file. All their
+	// addresses are worked out (and fetched into the cache) before any is
+	// read, so the memory accesses overlap rather than waiting in turn.
+	const uint8_t* child_values[MAX_MOVES];
+	if (to_move == PLAYER_1) {
+		Bitboard before[NUM_SYMMETRIES];
+		memcpy(before, p1_images, sizeof(before));
+		for (uint8_t i = 0; i < num_moves; i++) {
+			uint8_t to = move_to(all_moves[i]);
+			uint8_t from = drop ? NUM_SQUARES : move_from(all_moves[i]);
+			for (uint8_t symmetry = 0; symmetry < NUM_SYMMETRIES; symmetry++) {
+				p1_images[symmetry] = before[symmetry] ^
+						square_images[symmetry][to] ^ square_images[symmetry][from];
+			}
+			child_values[i] = value_address(db, child_layer, p1_count + drop,
+					p1_images, p2_images);
+			if (child_values[i]) {
+				__builtin_prefetch(child_values[i]);
+			}
+		}
+	} else {
+		// Player 1's pieces stay put, so their canonical form, and so
+		// where the values for them start, is the same for every move.
+		// Only the symmetries which give it (usually just one) can give
+		// the canonical form of player 2's pieces.
+		Bitboard p1_canonical = p1_images[SYMMETRY_IDENTITY];
+		uint8_t symmetries = 1 << SYMMETRY_IDENTITY;
+		for (uint8_t symmetry = 1; symmetry < NUM_SYMMETRIES; symmetry++) {
+			if (p1_images[symmetry] < p1_canonical) {
+				p1_canonical = p1_images[symmetry];
+				symmetries = 1 << symmetry;
+			} else if (p1_images[symmetry] == p1_canonical) {
+				symmetries |= 1 << symmetry;
+			}
+		}
+		uint32_t class_index =
+				db->class_tables[p1_count][db_rank_set(p1_canonical)];
+		if (class_index == DB_NO_CLASS) {
+			return 0;
+		}
+		const uint8_t* class_values = db->layers[child_layer] +
+				(size_t)class_index * db->p2_sets[child_layer];
+		for (uint8_t i = 0; i < num_moves; i++) {
+			uint8_t to = move_to(all_moves[i]);
+			uint8_t from = drop ? NUM_SQUARES : move_from(all_moves[i]);
+			Bitboard p2_canonical = ~(Bitboard)0;
+			for (uint8_t symmetry = 0; symmetry < NUM_SYMMETRIES; symmetry++) {
+				if (symmetries & (1 << symmetry)) {
+					Bitboard image = p2_images[symmetry] ^
+							square_images[symmetry][to] ^
+							square_images[symmetry][from];
+					if (image < p2_canonical) {
+						p2_canonical = image;
+					}
+				}
+			}
+			child_values[i] = class_values +
+					db_rank_set_excluding(p2_canonical, p1_canonical);
+			__builtin_prefetch(child_values[i]);
+		}
+	}
+	uint8_t num_best = 0;
+	for (uint8_t i = 0; i < num_moves; i++) {
+		if (child_values[i] && *child_values[i] == wanted) {
+			moves[num_best++] = all_moves[i];
+		}
+	}
+	return num_best;
+}
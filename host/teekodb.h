@@ -0,0 +1,48 @@
+/*
+ * teekodb.h
+ *
+ * Read-only access to a solved Teeko database (as written by teeko-solve).
+ * The file is memory-mapped and read in place: opening it maps the file and
+ * checks the header and class tables, and each lookup is a couple of table
+ * reads into the mapping. A handle can be shared by any number of threads.
+ *
+ * teeko-query -b times both calls. For random positions on a 2.1 GHz
+ * Xeon, teekodb_value() takes about 150 ns and teekodb_best_moves() about
+ * 0.6 us when the values it reads are already cached, rising to 1.3-2 us
+ * when they all have to come from memory, as it reads one value per legal
+ * move (the reads overlap, but are still scattered through the file).
+ */
+
+
+#ifndef TEEKODB_H_
+#define TEEKODB_H_
+
+#include <stdint.h>
+#include "teeko.h"
+#include "dbformat.h"
+
+typedef struct TeekoDb TeekoDb;
+
+// map the database in 'filename'. Returns 0 (NULL) and prints a message
+// to stderr if the file can't be opened or isn't a database.
+TeekoDb* teekodb_open(const char* filename);
+void teekodb_close(TeekoDb* db);
+
+// Returns the value of the position where player 1 has the pieces 'p1',
+// player 2 has 'p2' and 'to_move' (PLAYER_1 or PLAYER_2) is to move, as
+// a value byte (see dbformat.h). Positions with impossible piece counts,
+// overlapping pieces, pieces off the board (bits 25 and up) or a
+// 'to_move' which isn't PLAYER_1 or PLAYER_2 are DB_INVALID.
+uint8_t teekodb_value(const TeekoDb* db, Bitboard p1, Bitboard p2,
+		uint8_t to_move);
+
+// Fills 'moves' (room for MAX_MOVES) with every move which keeps the
+// best value for the player to move, and returns how many there are.
+// This looks up the position after each legal move, but transforms the
+// position only once, so most of its cost is reading those values.
+// '*value' (if not NULL) is set to the value of the position.
+uint8_t teekodb_best_moves(const TeekoDb* db, Bitboard p1, Bitboard p2,
+		uint8_t to_move, MoveCode* moves, uint8_t* value);
+
+
+#endif /* TEEKODB_H_ */